@@ -0,0 +1,113 @@
+#define BOOST_GRAPH_USE_SPIRIT_PARSER // for header only
+
+/*!
+  @file boolean_monitor_bench.cc
+  @brief Throughput benchmark of NonSymbolic::BooleanMonitor
+
+  The monitor runs the automata in example/copy and example/withdraw on synthetic timed words, and we report the
+  number of the configurations processed per second. A configuration is counted each time the monitor processes it
+  for an event.
+
+  Usage: boolean_monitor_bench [number of events] [number of threads]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "automaton_parser.hh"
+#include "boolean_monitor.hh"
+
+#ifndef PROJECT_ROOT
+#define PROJECT_ROOT ".."
+#endif
+
+namespace {
+  using Number = double;
+
+  //! @brief Discard the results of the monitor
+  struct NullObserver : public Observer<BooleanMonitorResult<Number>> {
+    void notify(const BooleanMonitorResult<Number> &) override {
+      ++matches;
+    }
+    std::size_t matches = 0;
+  };
+
+  NonParametricTA<Number> loadAutomaton(const std::string &fileName) {
+    std::ifstream stream(fileName);
+    if (stream.fail()) {
+      std::cerr << "Error: cannot open " << fileName << std::endl;
+      std::exit(1);
+    }
+    NonParametricBoostTA<Number> boostTA;
+    NonParametricTA<Number> TA;
+    parseBoostTA(stream, boostTA);
+    convBoostTA(boostTA, TA);
+    return TA;
+  }
+
+  //! @brief "update" events whose string is either "x" or "y", i.e., the workload of example/copy
+  std::vector<TimedWordEvent<Number>> copyWord(std::size_t size) {
+    std::mt19937 engine(1);
+    std::uniform_int_distribution<int> name(0, 1);
+    std::uniform_int_distribution<int> value(0, 3);
+    std::uniform_real_distribution<double> interval(0.1, 0.5);
+    std::vector<TimedWordEvent<Number>> word(size);
+    double timestamp = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      timestamp += interval(engine);
+      word[i] = {0, {name(engine) ? "x" : "y"}, {static_cast<Number>(value(engine))}, timestamp};
+    }
+    return word;
+  }
+
+  /*!
+    @brief "withdraw" events of 64 users, i.e., the workload of example/withdraw
+
+    @param interval The interval of the events. The shorter it is, the more configurations we have.
+   */
+  std::vector<TimedWordEvent<Number>> withdrawWord(std::size_t size, double interval = 0.25) {
+    std::mt19937 engine(2);
+    std::uniform_int_distribution<int> name(0, 63);
+    std::uniform_int_distribution<int> value(1, 10000);
+    std::vector<TimedWordEvent<Number>> word(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      word[i] = {0, {"user" + std::to_string(name(engine))}, {static_cast<Number>(value(engine))}, interval * i};
+    }
+    return word;
+  }
+
+  void run(const std::string &name, const NonParametricTA<Number> &automaton,
+           const std::vector<TimedWordEvent<Number>> &word, std::size_t threads) {
+    auto observer = std::make_shared<NullObserver>();
+    std::size_t configurations = 0;
+    const auto start = std::chrono::steady_clock::now();
+    {
+      NonSymbolic::BooleanMonitor<Number> monitor(automaton, threads);
+      monitor.addObserver(observer);
+      for (const auto &event: word) {
+        configurations += monitor.size();
+        monitor.notify(event);
+      }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name.c_str() << "\tevents: " << word.size() << "\tconfigurations: " << configurations
+              << "\tmatches: " << observer->matches << "\tseconds: " << elapsed.count()
+              << "\tconfigurations/s: " << configurations / elapsed.count() << std::endl;
+  }
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+  const std::size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+  run("copy", loadAutomaton(PROJECT_ROOT "/example/copy/copy.dot"), copyWord(size), threads);
+  run("withdraw", loadAutomaton(PROJECT_ROOT "/example/withdraw/withdraw.dot"), withdrawWord(size), threads);
+  // Each event sees thousands of configurations. It is the workload of the parallel mode.
+  run("withdraw-dense", loadAutomaton(PROJECT_ROOT "/example/withdraw/withdraw.dot"), withdrawWord(size / 10, 0.01),
+      threads);
+  return 0;
+}
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*!
+  @brief The binary format of the results of the monitors, printed with `--output-format binary`
+
+  The output starts with a header, and each match is a record prefixed by the length of its payload, so a reader can
+  skip the records it does not need. The integers are little endian, and f64 is an IEEE 754 double.
+
+  - Header: the magic "SYMONRES", u16 version, and u8 Kind
+  - Record: u32 length and the payload of the length, which is one of the following:
+    - Kind::Boolean: u64 index, f64 timestamp, Strings, u32 n, and n x (u8 set, followed by f64 value if set)
+    - Kind::DataParametric: u64 index, f64 timestamp, Strings, and Polyhedron of the number variables
+    - Kind::Parametric: u64 index, Integer numerator and Integer denominator of the timestamp, Strings, Polyhedron of
+      the number variables, and Polyhedron of the parameters and the clocks
+  - String: u32 length and the bytes
+  - Integer: String of the decimal digits with '-' if it is negative
+  - Strings: u32 n, and n x (u8 StringKind, followed by String value if Equal, or u32 k and k x String in the
+    lexicographic order if NotIn)
+  - Polyhedron: u32 dimension, u8 empty, u32 k, and k x Constraint, the minimized constraints
+  - Constraint: u8 Relation, dimension x Integer coefficients, and Integer inhomogeneous term. It means
+    coefficients[0] * x0 + ... + inhomogeneous term (Relation) 0.
+ */
+namespace BinaryResult {
+  constexpr std::string_view magic = "SYMONRES";
+  constexpr std::uint16_t version = 1;
+
+  enum class Kind : std::uint8_t { Boolean = 1, DataParametric = 2, Parametric = 3 };
+  enum class StringKind : std::uint8_t {
+    //! @brief The value is not any of the strings (symbolic monitors).
+    NotIn = 0,
+    Equal = 1,
+    //! @brief The value is unknown (Boolean monitor).
+    Unset = 2
+  };
+  enum class Relation : std::uint8_t { Equal = 0, GreaterEqual = 1, Greater = 2 };
+
+  //! @brief A string variable
+  struct StringValue {
+    StringKind kind;
+    //! @brief The value if kind is Equal, or the strings the value is not if kind is NotIn
+    std::vector<std::string> strings;
+  };
+
+  struct Constraint {
+    Relation relation;
+    std::vector<std::string> coefficients;
+    std::string inhomogeneousTerm;
+  };
+
+  struct Polyhedron {
+    std::uint32_t dimension = 0;
+    bool empty = false;
+    std::vector<Constraint> constraints;
+  };
+
+  //! @brief A record. The fields not in the kind of the results are empty.
+  struct Record {
+    std::uint64_t index = 0;
+    //! @brief The timestamp of Kind::Boolean and Kind::DataParametric
+    double timestamp = 0;
+    //! @brief The timestamp of Kind::Parametric
+    std::string timestampNumerator, timestampDenominator;
+    std::vector<StringValue> stringValuation;
+    //! @brief The number valuation of Kind::Boolean
+    std::vector<std::optional<double>> numberValuation;
+    //! @brief The number valuation of Kind::DataParametric and Kind::Parametric
+    Polyhedron numberPolyhedron;
+    //! @brief The parameters and the clocks of Kind::Parametric
+    Polyhedron timingPolyhedron;
+  };
+
+  //! @brief Build the header and the records in a reusable buffer
+  class Encoder {
+  public:
+    //! @brief Start a new buffer with the header.
+    void header(Kind kind) {
+      bytes.assign(magic.begin(), magic.end());
+      putU16(version);
+      putU8(static_cast<std::uint8_t>(kind));
+    }
+
+    //! @brief Start a new buffer with a record. Its length is filled by endRecord().
+    void beginRecord() {
+      bytes.clear();
+      putU32(0);
+    }
+
+    void endRecord() {
+      const auto length = static_cast<std::uint32_t>(bytes.size() - sizeof(std::uint32_t));
+      for (std::size_t i = 0; i < sizeof(std::uint32_t); ++i) {
+        bytes[i] = static_cast<char>(length >> (8 * i));
+      }
+    }
+
+    //! @brief Returns the bytes of the header or the record.
+    [[nodiscard]] std::string_view data() const {
+      return bytes;
+    }
+
+    void putU8(std::uint8_t value) {
+      bytes.push_back(static_cast<char>(value));
+    }
+    void putU16(std::uint16_t value) {
+      putLittleEndian(value);
+    }
+    void putU32(std::uint32_t value) {
+      putLittleEndian(value);
+    }
+    void putU64(std::uint64_t value) {
+      putLittleEndian(value);
+    }
+    void putF64(double value) {
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      putLittleEndian(bits);
+    }
+    void putString(std::string_view str) {
+      putU32(static_cast<std::uint32_t>(str.size()));
+      bytes.append(str);
+    }
+
+  private:
+    std::string bytes;
+
+    template <typename Unsigned> void putLittleEndian(Unsigned value) {
+      for (std::size_t i = 0; i < sizeof(Unsigned); ++i) {
+        bytes.push_back(static_cast<char>(value >> (8 * i)));
+      }
+    }
+  };
+
+  /*!
+    @brief Read the records from a stream in the binary format
+
+    @throws std::runtime_error If the header is not of this format, or if a record is truncated or malformed
+   */
+  class Reader {
+  public:
+    explicit Reader(std::istream &is) : is(is) {
+      std::string header(magic.size() + sizeof(std::uint16_t) + sizeof(std::uint8_t), '\0');
+      if (!is.read(header.data(), header.size()) || std::string_view(header).substr(0, magic.size()) != magic) {
+        throw std::runtime_error("BinaryResult: not a result of SyMon in the binary format");
+      }
+      payload = std::move(header);
+      position = magic.size();
+      if (getU16() != version) {
+        throw std::runtime_error("BinaryResult: unsupported version");
+      }
+      const std::uint8_t kind = getU8();
+      if (kind < static_cast<std::uint8_t>(Kind::Boolean) || kind > static_cast<std::uint8_t>(Kind::Parametric)) {
+        throw std::runtime_error("BinaryResult: unknown kind of the results");
+      }
+      resultKind = static_cast<Kind>(kind);
+    }
+
+    [[nodiscard]] Kind kind() const {
+      return resultKind;
+    }
+
+    /*!
+      @brief Read the next record. The storage of the given record is reused.
+
+      @returns false if there are no more records
+     */
+    bool next(Record &record) {
+      char length[sizeof(std::uint32_t)];
+      if (!is.read(length, sizeof(length))) {
+        if (is.gcount() != 0) {
+          throw std::runtime_error("BinaryResult: truncated record");
+        }
+        return false;
+      }
+      payload.assign(length, sizeof(length));
+      position = 0;
+      const std::uint32_t size = getU32();
+      // The payload is read in chunks so that a corrupted length does not allocate much more memory than the input.
+      payload.clear();
+      while (payload.size() < size) {
+        const std::size_t offset = payload.size();
+        payload.resize(offset + std::min<std::size_t>(size - offset, chunkSize));
+        if (!is.read(payload.data() + offset, payload.size() - offset)) {
+          throw std::runtime_error("BinaryResult: truncated record");
+        }
+      }
+      position = 0;
+      record.index = getU64();
+      if (resultKind == Kind::Parametric) {
+        getString(record.timestampNumerator);
+        getString(record.timestampDenominator);
+      } else {
+        record.timestamp = getF64();
+      }
+      record.stringValuation.resize(getCount(sizeof(std::uint8_t)));
+      for (StringValue &value: record.stringValuation) {
+        getStringValue(value);
+      }
+      if (resultKind == Kind::Boolean) {
+        record.numberValuation.resize(getCount(sizeof(std::uint8_t)));
+        for (std::optional<double> &value: record.numberValuation) {
+          value.reset();
+          if (getU8()) {
+            value = getF64();
+          }
+        }
+      } else {
+        getPolyhedron(record.numberPolyhedron);
+        if (resultKind == Kind::Parametric) {
+          getPolyhedron(record.timingPolyhedron);
+        }
+      }
+      if (position != payload.size()) {
+        throw std::runtime_error("BinaryResult: malformed record");
+      }
+      return true;
+    }
+
+  private:
+    //! @brief The maximum number of the bytes of a record read at once
+    static constexpr std::size_t chunkSize = 1 << 16;
+
+    std::istream &is;
+    Kind resultKind;
+    //! @brief The current record, or the header in the constructor
+    std::string payload;
+    std::size_t position = 0;
+
+    template <typename Unsigned> Unsigned getLittleEndian() {
+      if (payload.size() - position < sizeof(Unsigned)) {
+        throw std::runtime_error("BinaryResult: malformed record");
+      }
+      Unsigned value = 0;
+      for (std::size_t i = 0; i < sizeof(Unsigned); ++i) {
+        value |= static_cast<Unsigned>(static_cast<unsigned char>(payload[position++])) << (8 * i);
+      }
+      return value;
+    }
+    std::uint8_t getU8() {
+      return getLittleEndian<std::uint8_t>();
+    }
+    std::uint16_t getU16() {
+      return getLittleEndian<std::uint16_t>();
+    }
+    std::uint32_t getU32() {
+      return getLittleEndian<std::uint32_t>();
+    }
+    std::uint64_t getU64() {
+      return getLittleEndian<std::uint64_t>();
+    }
+    double getF64() {
+      const std::uint64_t bits = getU64();
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+    //! @brief Read the number of the following items, each of which has at least the given size.
+    std::size_t getCount(std::size_t itemSize) {
+      const std::uint32_t count = getU32();
+      if ((payload.size() - position) / itemSize < count) {
+        throw std::runtime_error("BinaryResult: malformed record");
+      }
+      return count;
+    }
+    void getString(std::string &str) {
+      const std::uint32_t size = getU32();
+      if (payload.size() - position < size) {
+        throw std::runtime_error("BinaryResult: malformed record");
+      }
+      str.assign(payload, position, size);
+      position += size;
+    }
+
+    void getStringValue(StringValue &value) {
+      const std::uint8_t kind = getU8();
+      if (kind > static_cast<std::uint8_t>(StringKind::Unset)) {
+        throw std::runtime_error("BinaryResult: malformed record");
+      }
+      value.kind = static_cast<StringKind>(kind);
+      switch (value.kind) {
+        case StringKind::NotIn:
+          value.strings.resize(getCount(sizeof(std::uint32_t)));
+          break;
+        case StringKind::Equal:
+          value.strings.resize(1);
+          break;
+        case StringKind::Unset:
+          value.strings.clear();
+          break;
+      }
+      for (std::string &str: value.strings) {
+        getString(str);
+      }
+    }
+
+    void getPolyhedron(Polyhedron &polyhedron) {
+      polyhedron.dimension = getU32();
+      polyhedron.empty = getU8();
+      // A constraint has the relation and the lengths of the coefficients and the inhomogeneous term.
+      polyhedron.constraints.resize(
+          getCount(sizeof(std::uint8_t) + sizeof(std::uint32_t) * (std::size_t{polyhedron.dimension} + 1)));
+      for (Constraint &constraint: polyhedron.constraints) {
+        const std::uint8_t relation = getU8();
+        if (relation > static_cast<std::uint8_t>(Relation::Greater)) {
+          throw std::runtime_error("BinaryResult: malformed record");
+        }
+        constraint.relation = static_cast<Relation>(relation);
+        constraint.coefficients.resize(polyhedron.dimension);
+        for (std::string &coefficient: constraint.coefficients) {
+          getString(coefficient);
+        }
+        getString(constraint.inhomogeneousTerm);
+      }
+    }
+  };
+} // namespace BinaryResult
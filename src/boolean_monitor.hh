@@ -3,11 +3,21 @@
 //(setq flycheck-clang-language-standard "c++17")
 
 #include "automaton.hh"
+#include "compiled_automaton.hh"
+#include "configuration_frontier.hh"
+#include "epsilon_closure.hh"
+#include "guard_horizons.hh"
+#include "monitor_budget.hh"
 #include "non_symbolic_update.hh"
 #include "observer.hh"
 #include "subject.hh"
+#include "thread_pool.hh"
 #include "timed_word_subject.hh"
-#include <boost/unordered_set.hpp>
+#include "zone.hh"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
 
 template <class Number> struct BooleanMonitorResult {
   std::size_t index;
@@ -17,169 +27,400 @@ template <class Number> struct BooleanMonitorResult {
 };
 
 namespace NonSymbolic {
-  template <typename Number>
+  /*!
+    @brief A configuration of BooleanMonitor
+
+    The clock valuation and the valuations of the variables are stored inline if they are small. The hash value is
+    computed once when the configuration is committed to a ConfigurationFrontier, which caches it.
+   */
+  template <typename Number, typename ClockValuation = TimingValuation> struct BooleanConfiguration {
+    //! @brief The index of the current state in the compiled automaton of BooleanMonitor
+    std::uint32_t state = 0;
+    ClockValuation clockValuation;
+    StringValuation stringEnv;
+    NumberValuation<Number> numberEnv;
+    //! @brief The absolute time of the last transition
+    double absTime = 0;
+    //! @brief The index of the event at which the partial match left an initial state. It is not compared.
+    std::size_t start = 0;
+
+    BooleanConfiguration() = default;
+    BooleanConfiguration(std::uint32_t state, ClockValuation clockValuation, StringValuation stringEnv,
+                         NumberValuation<Number> numberEnv, double absTime)
+        : state(state), clockValuation(std::move(clockValuation)), stringEnv(std::move(stringEnv)),
+          numberEnv(std::move(numberEnv)), absTime(absTime) {
+    }
+
+    bool operator==(const BooleanConfiguration &other) const {
+      return state == other.state && absTime == other.absTime && clockValuation == other.clockValuation &&
+             stringEnv == other.stringEnv && numberEnv == other.numberEnv;
+    }
+
+    friend std::size_t hash_value(const BooleanConfiguration &conf) {
+      std::size_t seed = conf.state;
+      boost::hash_combine(seed, conf.absTime);
+      hashClockValuation(seed, conf.clockValuation);
+      for (const auto &str: conf.stringEnv) {
+        // The id 0 is the empty string. We use it for the unset variables.
+        boost::hash_combine(seed, str ? str->id() + 1 : 0);
+      }
+      for (const auto &num: conf.numberEnv) {
+        boost::hash_combine(seed, num ? boost::hash<Number>{}(*num) : 0);
+      }
+      return seed;
+    }
+
+    [[nodiscard]] std::size_t approximateBytes() const {
+      return sizeof(BooleanConfiguration) + externalMemoryInBytes(clockValuation) + externalMemoryInBytes(stringEnv) +
+             externalMemoryInBytes(numberEnv);
+    }
+  };
+
+  /*!
+    @tparam ClockValuation The domain of the clocks: TimingValuation for the concrete clock values, or Zone to merge
+    the configurations whose clocks are in the same zone after extrapolation
+   */
+  template <typename Number, typename ClockValuation = TimingValuation>
   class BooleanMonitor : public SingleSubject<BooleanMonitorResult<Number>>, public Observer<TimedWordEvent<Number>> {
   public:
     static const constexpr std::size_t unobservableActionID = 127;
-    BooleanMonitor(const NonParametricTA<Number> &automaton) : automaton(automaton) {
+    //! @brief The Boolean monitor uses no PPL, so it can use more than one thread and run apart from the printer.
+    static constexpr bool isThreadSafe = true;
+    /*!
+      @param threads The number of the threads to expand the configurations. If it is more than one, large frontiers
+      are split into chunks expanded in parallel, and the results are merged in the order of the chunks. Therefore,
+      the matches are notified in the same order as the single-threaded monitor.
+      @param budget The budget of the configurations. The policy must be BudgetPolicy::Abort or BudgetPolicy::Drop.
+      @throws std::runtime_error If the policy of the budget is BudgetPolicy::Merge, which needs symbolic valuations
+     */
+    BooleanMonitor(const NonParametricTA<Number> &automaton, std::size_t threads = 1, MonitorBudget budget = {})
+        : automaton(automaton), compiled(automaton), guards(compileGuards(automaton, compiled)),
+          maxConstants(computeMaxConstants(automaton, guards)),
+          horizons(compiled, automaton.clockVariableSize,
+                   [this](std::size_t edgeIndex) -> const TimingBounds & { return guards[edgeIndex].timing; }),
+          epsilonClosure(compiled, unobservableActionID), budget(std::move(budget)) {
+      if (this->budget.policy == BudgetPolicy::Merge) {
+        throw std::runtime_error("BooleanMonitor: the merge policy of the budget needs symbolic valuations");
+      }
+      if (threads > 1) {
+        pool = std::make_unique<ThreadPool>(threads);
+      }
       configurations.clear();
-      // configurations.reserve(automaton.initialStates.size());
-      std::vector<double> initCVal(automaton.clockVariableSize);
+      ClockValuation initCVal(automaton.clockVariableSize);
       // by default, initSEnv is no violating set (variant)
       StringValuation initSEnv(automaton.stringVariableSize);
       // by default, initNEnv is unset (optional)
       NumberValuation<Number> initNEnv(automaton.numberVariableSize);
-      for (const auto &initialState: automaton.initialStates) {
+      for (const auto initialState: compiled.initialStates()) {
         configurations.insert({initialState, initCVal, initSEnv, initNEnv, 0});
       }
     }
+    //! @brief The Boolean monitor needs no per-thread initialization.
+    static std::shared_ptr<void> makeThreadContext() {
+      return nullptr;
+    }
     virtual ~BooleanMonitor() {
       epsilonTransition(configurations);
     }
-    void notify(const TimedWordEvent<Number> &event) {
-      const Action actionId = event.actionId;
-      const std::vector<std::string> &strings = event.strings;
-      const std::vector<Number> &numbers = event.numbers;
-      const double timestamp = event.timestamp;
-
-      boost::unordered_set<Configuration> nextConfigurations;
-      configurations.merge(epsilonTransition(configurations));
-
-      for (const Configuration &conf: configurations) {
-        // make the current env
-        auto clockValuation = std::get<1>(conf); // conf.clockValuation;
-        const auto absTime = std::get<4>(conf);
-        if (timestamp < absTime) {
-          continue;
-        }
-        for (double &d: clockValuation) {
-          d += timestamp - absTime;
+    void notify(const TimedWordEvent<Number> &event) override {
+      epsilonTransition(configurations);
+      nextConfigurations.clear();
+
+      const std::size_t size = configurations.size();
+      if (!pool || size < 2 * minimumChunkSize) {
+        const auto scratch = [this]() -> Configuration & { return nextConfigurations.scratch(); };
+        const auto commit = [this](const Configuration &nextConf, bool isMatch, bool isLive) {
+          if (isMatch) {
+            this->notifyObservers({index, nextConf.absTime, nextConf.numberEnv, nextConf.stringEnv});
+          }
+          if (isLive) {
+            nextConfigurations.commit();
+          }
+        };
+        for (const Configuration &conf: configurations) {
+          expand(conf, event, buffers.front(), scratch, commit);
         }
-        auto stringEnv = std::get<2>(conf); // conf.stringEnv;
-        stringEnv.insert(stringEnv.end(), strings.begin(), strings.end());
-        auto numberEnv = std::get<3>(conf); // conf.numberEnv;
-        numberEnv.insert(numberEnv.end(), numbers.begin(), numbers.end());
-
-        auto transitionIt = std::get<0>(conf)->next.find(actionId); // conf.state->next.find(actionId);
-        if (transitionIt == std::get<0>(conf)->next.end()           // ;conf.state->next.end()
-        ) {
-          continue;
+      } else {
+        const std::size_t chunkSize = std::max(minimumChunkSize, size / (pool->size() * chunksPerThread) + 1);
+        const std::size_t chunks = (size + chunkSize - 1) / chunkSize;
+        if (buffers.size() < chunks) {
+          buffers.resize(chunks);
         }
-        for (const auto &transition: transitionIt->second) {
-          // evaluate the guards
-          auto nextSEnv = stringEnv;
-          if (eval(clockValuation, transition.guard) &&
-              eval(transition.stringConstraints, nextSEnv, transition.numConstraints, numberEnv)) {
-            auto nextCVal = clockValuation;
-            auto nextNEnv = numberEnv;
-            for (const VariableID resetVar: transition.resetVars) {
-              nextCVal[resetVar] = 0;
+        pool->parallelFor(chunks, [&](std::size_t chunk) {
+          Expansion &buffer = buffers[chunk];
+          buffer.size = 0;
+          const auto scratch = [&buffer]() -> Configuration & { return buffer.scratch(); };
+          const auto commit = [&buffer](const Configuration &, bool isMatch, bool isLive) {
+            buffer.commit(isMatch, isLive);
+          };
+          const std::size_t end = std::min(size, (chunk + 1) * chunkSize);
+          for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+            expand(configurations[i], event, buffer, scratch, commit);
+          }
+        });
+        // Merge the successors in the order of the chunks, which is the order of the sequential expansion.
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+          Expansion &buffer = buffers[chunk];
+          for (std::size_t i = 0; i < buffer.size; ++i) {
+            Configuration &nextConf = buffer.successors[i];
+            if (buffer.isMatch[i]) {
+              this->notifyObservers({index, nextConf.absTime, nextConf.numberEnv, nextConf.stringEnv});
             }
-            transition.update.execute(nextSEnv, nextNEnv);
-            nextSEnv.resize(automaton.stringVariableSize);
-            nextNEnv.resize(automaton.numberVariableSize);
-            auto target = transition.target.lock();
-            if (!target) {
+            if (!buffer.isLive[i]) {
               continue;
             }
-            nextConfigurations.insert({target, std::move(nextCVal), nextSEnv, nextNEnv, timestamp});
-            if (target->isMatch) {
-              this->notifyObservers({index, timestamp, nextNEnv, nextSEnv});
-            }
+            // We swap instead of copying so that both buffers keep recycled storage.
+            std::swap(nextConfigurations.scratch(), nextConf);
+            nextConfigurations.commit();
           }
         }
       }
       index++;
-      configurations = std::move(nextConfigurations);
+      std::swap(configurations, nextConfigurations);
+      enforceBudget();
+    }
+
+    //! @brief Process the events in order without the virtual dispatch per event.
+    void notifyBatch(const TimedWordEvent<Number> *events, std::size_t size) override {
+      for (std::size_t i = 0; i < size; ++i) {
+        BooleanMonitor::notify(events[i]);
+      }
+    }
+
+    //! @brief Returns the number of the current configurations.
+    [[nodiscard]] std::size_t size() const {
+      return configurations.size();
     }
 
   private:
+    using State = NonParametricTAState<Number>;
     const NonParametricTA<Number> automaton;
-    using Configuration = std::tuple<std::shared_ptr<NonParametricTAState<Number>>, std::vector<double>,
-                                     StringValuation, NumberValuation<Number>, double>;
-    // struct Configuration {
-    //   std::shared_ptr<AutomatonState<Number>> state;
-    //   std::vector<double> clockValuation;
-    //   StringValuation stringEnv;
-    //   NumberValuation<Number> numberEnv;
-    //   bool operator==(const Configuration x) const {
-    //     return state == x.state && clockValuation == x.clockValuation && stringEnv == x.stringEnv && numberEnv ==
-    //     x.numberEnv;
-    //   }
-    // };
-    boost::unordered_set<Configuration> configurations;
+    using Configuration = BooleanConfiguration<Number, ClockValuation>;
+    //! @brief A chunk with fewer configurations is not worth a task.
+    static constexpr std::size_t minimumChunkSize = 256;
+    //! @brief We make more chunks than threads to balance the load.
+    static constexpr std::size_t chunksPerThread = 4;
+
+    /*!
+      @brief The working storage to expand configurations, which is recycled across events
+
+      In the parallel mode, each chunk has its own Expansion holding its successors.
+     */
+    struct Expansion {
+      //! @brief The buffers of the valuations extended with the current event
+      ClockValuation clockValuation;
+      StringValuation stringEnv;
+      NumberValuation<Number> numberEnv;
+      //! @brief The first size elements are the successors in the order of the expansion.
+      std::vector<Configuration> successors;
+      //! @brief If isMatch[i] is true, successors[i] is at an accepting state.
+      std::vector<bool> isMatch;
+      //! @brief If isLive[i] is false, successors[i] is only notified and then discarded.
+      std::vector<bool> isLive;
+      std::size_t size = 0;
+
+      Configuration &scratch() {
+        if (size == successors.size()) {
+          successors.emplace_back();
+          isMatch.push_back(false);
+          isLive.push_back(false);
+        }
+        return successors[size];
+      }
+      void commit(bool match, bool live) {
+        isMatch[size] = match;
+        isLive[size++] = live;
+      }
+    };
+
+    //! @brief The guard of an edge normalized at the construction of the monitor
+    struct CompiledGuard {
+      TimingBounds timing;
+      //! @brief The bytecode of the number guard and the number update
+      NumberProgram<Number> number;
+    };
+
+    /*!
+      @throws std::runtime_error If a guard refers to an undefined clock variable.
+     */
+    static std::vector<CompiledGuard> compileGuards(const NonParametricTA<Number> &automaton,
+                                                    const CompiledAutomaton<State> &compiled) {
+      std::vector<CompiledGuard> guards;
+      guards.reserve(compiled.allEdges().size());
+      for (const auto &edge: compiled.allEdges()) {
+        TimingBounds timing(edge.transition.guard);
+        if (timing.clockSize() > automaton.clockVariableSize) {
+          throw std::runtime_error("A guard refers to an undefined clock variable");
+        }
+        guards.push_back(
+            {std::move(timing), {edge.transition.numConstraints, edge.transition.update.numberUpdate}});
+      }
+      return guards;
+    }
+
+    static std::vector<double> computeMaxConstants(const NonParametricTA<Number> &automaton,
+                                                   const std::vector<CompiledGuard> &guards) {
+      std::vector<double> maxConstants(automaton.clockVariableSize, -std::numeric_limits<double>::infinity());
+      for (const CompiledGuard &guard: guards) {
+        guard.timing.updateMaxConstants(maxConstants);
+      }
+      return maxConstants;
+    }
+
+    /*!
+      @brief The configurations before and after the current event
+
+      Both frontiers persist across events and are swapped after each event so that their storage is recycled.
+     */
+    ConfigurationFrontier<Configuration> configurations, nextConfigurations;
+    //! @brief The buffers of the expansion. The first one is used in the sequential mode.
+    std::vector<Expansion> buffers = std::vector<Expansion>(1);
+    std::unique_ptr<ThreadPool> pool;
     std::size_t index = 0;
+    //! @brief The automaton taken by the configurations, which refer to their state by the index
+    const CompiledAutomaton<State> compiled;
+    //! @brief The compiled guard of each edge, indexed by compiled.edgeIndex
+    const std::vector<CompiledGuard> guards;
+    //! @brief The largest constant compared with each clock, used to extrapolate the zones
+    const std::vector<double> maxConstants;
+    //! @brief The successors beyond the horizons are discarded because they never match.
+    const GuardHorizons horizons;
+    //! @brief The unobservable transitions. If it is empty, we skip the epsilon transitions.
+    const EpsilonClosure<State> epsilonClosure;
+    const MonitorBudget budget;
+
+    //! @brief Drop the oldest partial matches if the configurations after the current event exceed the budget.
+    void enforceBudget() {
+      budget.record(configurations.size());
+      if (!budget.limits()) {
+        return;
+      }
+      const std::vector<std::size_t> bytes = budget.measure(configurations);
+      if (budget.allows(configurations.size(), MonitorBudget::total(bytes))) {
+        return;
+      }
+      budget.exceed(index, configurations.size(), MonitorBudget::total(bytes));
+      budget.dropOldest(index, configurations, bytes, [this](const Configuration &conf) {
+        return compiled.isInitial(conf.state) ? MonitorBudget::initialStart : conf.start;
+      });
+    }
+
+    /*!
+      @brief Compute the successors of a configuration by the given event.
+
+      @param scratch A function returning the storage of the next successor.
+      @param commit A function called with each successor, whether it is at an accepting state, and whether it may
+      reach an accepting state later. The successors that may not are only notified if they are at an accepting state.
+      @note This function is called concurrently in the parallel mode. It must not modify the monitor.
+     */
+    template <typename Scratch, typename Commit>
+    void expand(const Configuration &conf, const TimedWordEvent<Number> &event, Expansion &buffer,
+                const Scratch &scratch, const Commit &commit) const {
+      const auto edges = compiled.edges(conf.state, event.actionId);
+      if (edges.empty() || event.timestamp < conf.absTime) {
+        return;
+      }
+      // make the current env
+      buffer.clockValuation = conf.clockValuation;
+      elapse(buffer.clockValuation, event.timestamp - conf.absTime);
+      // We discard all the edges at once if no timing guard holds after the dwell time. The edges before the first
+      // satisfiable one are skipped, and the later ones are rejected by constrain().
+      const auto firstEdge = std::find_if(edges.begin(), edges.end(), [&](const auto &edge) {
+        return intersects(buffer.clockValuation, guards[compiled.edgeIndex(edge)].timing);
+      });
+      if (firstEdge == edges.end()) {
+        return;
+      }
+      buffer.stringEnv = conf.stringEnv;
+      buffer.stringEnv.insert(buffer.stringEnv.end(), event.strings.begin(), event.strings.end());
+      buffer.numberEnv = conf.numberEnv;
+      buffer.numberEnv.insert(buffer.numberEnv.end(), event.numbers.begin(), event.numbers.end());
+
+      for (auto it = firstEdge; it != edges.end(); ++it) {
+        const auto &edge = *it;
+        const auto &[transition, target] = edge;
+        const CompiledGuard &guard = guards[compiled.edgeIndex(edge)];
+        // evaluate the guards, starting from the timing guard since it is the cheapest
+        Configuration &nextConf = scratch();
+        nextConf.clockValuation = buffer.clockValuation;
+        if (!constrain(nextConf.clockValuation, guard.timing)) {
+          continue;
+        }
+        nextConf.stringEnv = buffer.stringEnv;
+        if (eval(transition.stringConstraints, nextConf.stringEnv, guard.number, buffer.numberEnv)) {
+          nextConf.state = target;
+          nextConf.numberEnv = buffer.numberEnv;
+          nextConf.absTime = event.timestamp;
+          nextConf.start = compiled.isInitial(conf.state) ? index : conf.start;
+          for (const VariableID resetVar: transition.resetVars) {
+            reset(nextConf.clockValuation, resetVar);
+          }
+          extrapolate(nextConf.clockValuation, maxConstants);
+          transition.update.executeString(nextConf.stringEnv);
+          guard.number.update(nextConf.numberEnv);
+          nextConf.stringEnv.resize(automaton.stringVariableSize);
+          nextConf.numberEnv.resize(automaton.numberVariableSize);
+          commit(nextConf, compiled.isMatch(target), horizons.isLive(target, nextConf.clockValuation));
+        }
+      }
+    }
 
     /**
     * Performs epsilon (unobservable) transitions starting from the given configurations.
     *
-    * This method repeatedly explores transitions labeled with the unobservable action
-    * from all current configurations, advancing time according to clock guards,
-    * applying clock resets and symbolic updates, and collecting all reachable
-    * configurations. Exploration continues until no further epsilon transitions
-    * are possible. Whenever a target state marked as a match is reached,
+    * This method explores transitions labeled with the unobservable action
+    * from all configurations in the frontier, advancing time according to clock guards,
+    * applying clock resets and symbolic updates, and appending the reached
+    * configurations to the frontier itself. Since the frontier is also the worklist,
+    * the exploration continues until no new configuration is reachable.
+    * Whenever a target state marked as a match is reached,
     * it notifies registered observers using the current index, absolute time, and valuations.
     *
-    * @param currentConfigurations
-    *        The initial set of configurations from which epsilon transitions
-    *        are taken. The set is passed by value and moved into an internal
-    *        worklist; it should not be used by the caller after this call.
-    *
-    * @return The set of configurations reachable via zero or more epsilon
-    *         transitions that cannot be further extended by additional epsilon
-    *         transitions.
-    *
+    * @param frontier
+    *        The configurations from which epsilon transitions are taken.
+    *        After this call, it also contains the configurations reachable
+    *        via one or more epsilon transitions.
     */
-    boost::unordered_set<Configuration> epsilonTransition(boost::unordered_set<Configuration> currentConfigurations) {
-      // the next configurations to explore
-      boost::unordered_set<Configuration> nextConfigurations;
-      // the configurations reachable via epsilon transitions
-      boost::unordered_set<Configuration> returnConfigurations;
-
-      while (!currentConfigurations.empty()) {
-        nextConfigurations.clear();
-        for (const Configuration &conf: currentConfigurations) {
-          auto transitionIt = std::get<0>(conf)->next.find(unobservableActionID);
-          if (transitionIt == std::get<0>(conf)->next.end()) {
-            continue;
-          }
+    void epsilonTransition(ConfigurationFrontier<Configuration> &frontier) {
+      if (epsilonClosure.empty()) {
+        return;
+      }
+      for (std::size_t i = 0; i < frontier.size(); ++i) {
+        for (const auto &[edge, equalities]: epsilonClosure.edges(frontier[i].state)) {
+          const auto &[transition, target] = *edge;
+          const CompiledGuard &guard = guards[compiled.edgeIndex(*edge)];
+          // scratch() may move the configurations. We must take conf after it.
+          Configuration &nextConf = frontier.scratch();
+          const Configuration &conf = frontier[i];
+          const auto df = diff(conf.clockValuation, equalities);
+          if (!df) continue;
           // make the current env
-          const auto clockValuation = std::get<1>(conf);
-          const auto stringEnv = std::get<2>(conf);
-          const auto numberEnv = std::get<3>(conf);
-          for (const auto &transition: transitionIt->second) {
-            // evaluate the guards
-            auto nextCVal = clockValuation;
-            auto nextSEnv = stringEnv;
-            auto nextNEnv = numberEnv;
-            auto extendedGuard = transition.guard;
-
-            auto absTime = std::get<4>(conf);
-            auto df = diff(nextCVal, extendedGuard);
-            if (!df) continue;
-            for (double &d: nextCVal) {
-              d += df.value();
+          nextConf.clockValuation = conf.clockValuation;
+          elapse(nextConf.clockValuation, df.value());
+          nextConf.stringEnv = conf.stringEnv;
+
+          // evaluate the guards
+          if (constrain(nextConf.clockValuation, guard.timing) &&
+              eval(transition.stringConstraints, nextConf.stringEnv, guard.number, conf.numberEnv)) {
+            nextConf.state = target;
+            nextConf.numberEnv = conf.numberEnv;
+            nextConf.absTime = conf.absTime + df.value();
+            nextConf.start = compiled.isInitial(conf.state) ? index : conf.start;
+            for (const VariableID resetVar: transition.resetVars) {
+              reset(nextConf.clockValuation, resetVar);
+            }
+            extrapolate(nextConf.clockValuation, maxConstants);
+            transition.update.executeString(nextConf.stringEnv);
+            guard.number.update(nextConf.numberEnv);
+            if (compiled.isMatch(target)) {
+              this->notifyObservers({index, nextConf.absTime, nextConf.numberEnv, nextConf.stringEnv});
             }
-            absTime += df.value();
-
-            if (eval(nextCVal, extendedGuard) &&
-                eval(transition.stringConstraints, nextSEnv, transition.numConstraints, nextNEnv)) {
-              for (const VariableID resetVar: transition.resetVars) {
-                nextCVal[resetVar] = 0;
-              }
-              auto nextState = transition.target.lock();
-              transition.update.execute(nextSEnv, nextNEnv);
-              nextConfigurations.insert({nextState, nextCVal, nextSEnv, nextNEnv, absTime});
-              returnConfigurations.insert({nextState, nextCVal, nextSEnv, nextNEnv, absTime});
-              if (nextState->isMatch) {
-                this->notifyObservers({index, absTime, nextNEnv, nextSEnv});
-              }
+            if (horizons.isLive(target, nextConf.clockValuation)) {
+              frontier.commit();
             }
           }
         }
-        std::swap(currentConfigurations, nextConfigurations);
       }
-      return returnConfigurations;
     }
   };
 } // namespace NonSymbolic
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "common_types.hh"
+
+/*!
+  @brief An automaton laid out in contiguous arrays for the monitors
+
+  It is built once from the pointer graph of an Automaton. The states are numbered by 32-bit indices, and the
+  transitions are stored contiguously grouped by their source state and action. The transitions of a state and an
+  action are found through a dense jump table indexed by the state and the action, and each transition has the index of
+  its target. Therefore, a monitor needs neither a hash lookup nor weak_ptr::lock() to take a transition.
+
+  @note The jump table has (the largest action + 1) columns for each state. This is small because the actions are the
+  ids in a signature, except for the unobservable action.
+  @tparam State The AutomatonState
+ */
+template <typename State> class CompiledAutomaton {
+public:
+  using Transition = typename decltype(State::next)::mapped_type::value_type;
+  using StateIndex = std::uint32_t;
+
+  //! @brief A transition with the index of its target state
+  struct Edge {
+    Transition transition;
+    StateIndex target;
+  };
+
+  //! @brief The contiguous edges of a state and an action
+  class EdgeRange {
+  public:
+    EdgeRange(const Edge *first, const Edge *last) : first(first), last(last) {
+    }
+    [[nodiscard]] const Edge *begin() const {
+      return first;
+    }
+    [[nodiscard]] const Edge *end() const {
+      return last;
+    }
+    [[nodiscard]] bool empty() const {
+      return first == last;
+    }
+    [[nodiscard]] std::size_t size() const {
+      return last - first;
+    }
+
+  private:
+    const Edge *first, *last;
+  };
+
+  CompiledAutomaton() = default;
+
+  /*!
+    @brief Compile the states reachable from the given automaton.
+
+    The states in automaton.states keep their order, and the targets outside of them are numbered after them.
+    Transitions whose target has expired are omitted.
+   */
+  explicit CompiledAutomaton(const Automaton<State> &automaton) {
+    std::unordered_map<const State *, StateIndex> indices;
+    std::vector<const State *> states;
+    const auto addState = [&](const State *state) {
+      if (indices.emplace(state, states.size()).second) {
+        states.push_back(state);
+      }
+    };
+    for (const auto &state: automaton.states) {
+      addState(state.get());
+    }
+    for (const auto &state: automaton.initialStates) {
+      addState(state.get());
+      initials.push_back(indices.at(state.get()));
+    }
+    actionSize = 0;
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      for (const auto &[action, transitions]: states[i]->next) {
+        for (const auto &transition: transitions) {
+          if (auto target = transition.target.lock()) {
+            addState(target.get());
+            actionSize = std::max(actionSize, action + 1);
+          }
+        }
+      }
+    }
+
+    matches.reserve(states.size());
+    offsets.reserve(states.size() * actionSize + 1);
+    offsets.push_back(0);
+    for (const State *state: states) {
+      matches.push_back(state->isMatch);
+      for (Action action = 0; action < actionSize; ++action) {
+        if (auto it = state->next.find(action); it != state->next.end()) {
+          for (const auto &transition: it->second) {
+            if (auto target = transition.target.lock()) {
+              edgeArray.push_back({transition, indices.at(target.get())});
+            }
+          }
+        }
+        offsets.push_back(edgeArray.size());
+      }
+    }
+  }
+
+  //! @brief Returns the number of the states.
+  [[nodiscard]] std::size_t stateSize() const {
+    return matches.size();
+  }
+
+  [[nodiscard]] const std::vector<StateIndex> &initialStates() const {
+    return initials;
+  }
+
+  [[nodiscard]] bool isInitial(StateIndex state) const {
+    return std::find(initials.begin(), initials.end(), state) != initials.end();
+  }
+
+  [[nodiscard]] bool isMatch(StateIndex state) const {
+    return matches[state];
+  }
+
+  //! @brief Returns the transitions from the state labeled with the action.
+  [[nodiscard]] EdgeRange edges(StateIndex state, Action action) const {
+    if (action >= actionSize) {
+      return {nullptr, nullptr};
+    }
+    const std::size_t slot = state * actionSize + action;
+    return {edgeArray.data() + offsets[slot], edgeArray.data() + offsets[slot + 1]};
+  }
+
+  //! @brief Returns the transitions from the state labeled with any action.
+  [[nodiscard]] EdgeRange edgesFrom(StateIndex state) const {
+    if (actionSize == 0) {
+      return {nullptr, nullptr};
+    }
+    return {edgeArray.data() + offsets[state * actionSize], edgeArray.data() + offsets[(state + 1) * actionSize]};
+  }
+
+  //! @brief Returns all the edges. They are grouped by their source state and action.
+  [[nodiscard]] EdgeRange allEdges() const {
+    return {edgeArray.data(), edgeArray.data() + edgeArray.size()};
+  }
+
+  //! @brief Returns the position of the edge in allEdges(), e.g., to look up data attached to it.
+  [[nodiscard]] std::size_t edgeIndex(const Edge &edge) const {
+    return &edge - edgeArray.data();
+  }
+
+  //! @brief Returns if any state has a transition labeled with the action.
+  [[nodiscard]] bool hasAction(Action action) const {
+    for (StateIndex state = 0; state < stateSize(); ++state) {
+      if (!edges(state, action).empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  std::size_t actionSize = 0;
+  std::vector<StateIndex> initials;
+  std::vector<bool> matches;
+  std::vector<Edge> edgeArray;
+  //! @brief The edges of the state s and the action a are edgeArray[offsets[s * actionSize + a], offsets[... + 1]).
+  std::vector<std::uint32_t> offsets;
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*!
+  @brief A set of configurations reused across events
+
+  The configurations are stored in a vector that never shrinks. clear() only resets the number of the configurations
+  and bumps the epoch of the hash index, and the storage of the cleared configurations (e.g., the heap buffers of their
+  valuations) is recycled when the next configurations are assigned to them. Therefore, once a frontier has grown to
+  the size of the workload, adding configurations allocates no memory.
+
+  A configuration is added in two steps: fill the configuration returned by scratch() and call commit(). If commit()
+  rejects a duplicate, the scratch is reused for the next configuration.
+
+  @tparam Configuration The configuration. It must be default constructible and equality comparable.
+  @tparam Hash The hash function of Configuration. The hash value is computed once in commit() and cached.
+ */
+template <typename Configuration, typename Hash = boost::hash<Configuration>> class ConfigurationFrontier {
+public:
+  using const_iterator = typename std::vector<Configuration>::const_iterator;
+
+  [[nodiscard]] std::size_t size() const {
+    return count;
+  }
+  [[nodiscard]] bool empty() const {
+    return count == 0;
+  }
+  const Configuration &operator[](std::size_t i) const {
+    return slots[i];
+  }
+  [[nodiscard]] const_iterator begin() const {
+    return slots.begin();
+  }
+  [[nodiscard]] const_iterator end() const {
+    return slots.begin() + count;
+  }
+
+  //! @brief Remove all the configurations keeping their storage
+  void clear() {
+    count = 0;
+    clearIndex();
+  }
+
+  /*!
+    @brief Returns the storage of the next configuration.
+
+    The returned configuration holds the contents of a cleared or rejected configuration. The caller must assign all
+    of its members before commit().
+
+    @note This invalidates the references to the configurations in this frontier.
+   */
+  Configuration &scratch() {
+    if (count == slots.size()) {
+      slots.emplace_back();
+      hashes.emplace_back();
+    }
+    return slots[count];
+  }
+
+  /*!
+    @brief Add the configuration in scratch() unless an equal configuration is already in this frontier.
+    @retval true If the configuration is added
+   */
+  bool commit() {
+    if (2 * (count + 1) > table.size()) {
+      grow();
+    }
+    const std::size_t hash = Hash{}(slots[count]);
+    std::size_t pos = hash & mask;
+    while (table[pos].epoch == epoch) {
+      const std::size_t i = table[pos].index;
+      if (hashes[i] == hash && slots[i] == slots[count]) {
+        return false;
+      }
+      pos = (pos + 1) & mask;
+    }
+    table[pos] = {epoch, static_cast<std::uint32_t>(count)};
+    hashes[count++] = hash;
+    return true;
+  }
+
+  /*!
+    @brief Add a copy of the given configuration unless an equal configuration is already in this frontier.
+    @pre conf is not a configuration in this frontier.
+    @retval true If the configuration is added
+   */
+  bool insert(const Configuration &conf) {
+    scratch() = conf;
+    return commit();
+  }
+
+  /*!
+    @brief Remove the configurations subsumed by another configuration in this frontier.
+
+    Only the configurations with the same key hash are compared, so the cost is quadratic only in the size of each
+    group. The remaining configurations keep their order, and the storage of the removed ones is recycled.
+
+    @param keyHash A function returning the hash of the part of a configuration that must be equal for subsumption
+    @param subsumes A function such that subsumes(a, b) returns if a subsumes b. It must be reflexive and transitive.
+    @returns The number of the removed configurations
+    @note This invalidates the references to the configurations in this frontier.
+   */
+  template <typename KeyHash, typename Subsumes> std::size_t removeSubsumed(KeyHash keyHash, Subsumes subsumes) {
+    removed.assign(count, false);
+    forEachGroup(keyHash, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        const std::size_t removedIndex = groups[i].second;
+        for (std::size_t j = begin; j < end && !removed[removedIndex]; ++j) {
+          const std::size_t keptIndex = groups[j].second;
+          // Of mutually subsuming configurations, we keep the first one.
+          removed[removedIndex] = i != j && !removed[keptIndex] && subsumes(slots[keptIndex], slots[removedIndex]) &&
+                                  (keptIndex < removedIndex || !subsumes(slots[removedIndex], slots[keptIndex]));
+        }
+      }
+    });
+    return remove(removed);
+  }
+
+  /*!
+    @brief Merge each group of the configurations with the same key into the first one of the group.
+
+    @param keyHash A function returning the hash of the key of a configuration
+    @param sameKey A function returning if two configurations have the same key
+    @param merge A function such that merge(a, b) merges b into a
+    @returns The number of the configurations merged into another
+    @note This invalidates the references to the configurations in this frontier.
+   */
+  template <typename KeyHash, typename SameKey, typename Merge>
+  std::size_t mergeGroups(KeyHash keyHash, SameKey sameKey, Merge merge) {
+    removed.assign(count, false);
+    forEachGroup(keyHash, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        const std::size_t keptIndex = groups[i].second;
+        for (std::size_t j = i + 1; j < end && !removed[keptIndex]; ++j) {
+          const std::size_t mergedIndex = groups[j].second;
+          if (!removed[mergedIndex] && sameKey(slots[keptIndex], slots[mergedIndex])) {
+            merge(slots[keptIndex], slots[mergedIndex]);
+            removed[mergedIndex] = true;
+          }
+        }
+      }
+    });
+    // The merged configurations have new hash values.
+    for (std::size_t i = 0; i < count; ++i) {
+      if (!removed[i]) {
+        hashes[i] = Hash{}(slots[i]);
+      }
+    }
+    const std::size_t removedSize = remove(removed);
+    if (removedSize == 0) {
+      clearIndex();
+      reindex();
+    }
+    return removedSize;
+  }
+
+  /*!
+    @brief Remove the configurations i such that flags[i] is true. The others keep their order.
+    @returns The number of the removed configurations
+    @note This invalidates the references to the configurations in this frontier.
+   */
+  std::size_t remove(const std::vector<bool> &flags) {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      if (flags[i]) {
+        continue;
+      }
+      if (size != i) {
+        std::swap(slots[size], slots[i]);
+        hashes[size] = hashes[i];
+      }
+      ++size;
+    }
+    const std::size_t removedSize = count - size;
+    if (removedSize > 0) {
+      count = size;
+      clearIndex();
+      reindex();
+    }
+    return removedSize;
+  }
+
+private:
+  //! @brief A bucket of the hash index. It is occupied if and only if its epoch is the current epoch.
+  struct Bucket {
+    std::uint32_t epoch = 0;
+    std::uint32_t index = 0;
+  };
+  std::vector<Configuration> slots;
+  //! @brief The hash values of the configurations in slots
+  std::vector<std::size_t> hashes;
+  //! @brief The open-addressing index of slots with linear probing
+  std::vector<Bucket> table;
+  std::size_t mask = 0;
+  std::size_t count = 0;
+  std::uint32_t epoch = 1;
+  /*!
+    @brief The working storage of removeSubsumed() and mergeGroups(): the pairs of the key hash and the index, and
+    the flags of the removed configurations
+   */
+  std::vector<std::pair<std::size_t, std::uint32_t>> groups;
+  std::vector<bool> removed;
+
+  /*!
+    @brief Call f(begin, end) for each group [begin, end) of groups, which are the indices of the configurations with
+    the same key hash sorted by the index.
+   */
+  template <typename KeyHash, typename F> void forEachGroup(KeyHash keyHash, F f) {
+    groups.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+      groups.emplace_back(keyHash(slots[i]), static_cast<std::uint32_t>(i));
+    }
+    std::sort(groups.begin(), groups.end());
+    for (std::size_t begin = 0, end; begin < groups.size(); begin = end) {
+      for (end = begin + 1; end < groups.size() && groups[end].first == groups[begin].first; ++end) {
+      }
+      f(begin, end);
+    }
+  }
+
+  //! @brief Empty the hash index in constant time by bumping the epoch.
+  void clearIndex() {
+    if (++epoch == 0) {
+      // The epoch wrapped around. We must not confuse the buckets of 2^32 clears ago with the current ones.
+      std::fill(table.begin(), table.end(), Bucket{});
+      epoch = 1;
+    }
+  }
+
+  //! @brief Insert the current configurations to the empty hash index.
+  void reindex() {
+    for (std::size_t i = 0; i < count; ++i) {
+      std::size_t pos = hashes[i] & mask;
+      while (table[pos].epoch == epoch) {
+        pos = (pos + 1) & mask;
+      }
+      table[pos] = {epoch, static_cast<std::uint32_t>(i)};
+    }
+  }
+
+  //! @brief Double the hash index and reinsert the current configurations.
+  void grow() {
+    const std::size_t tableSize = std::max<std::size_t>(16, table.size() * 2);
+    table.assign(tableSize, Bucket{});
+    mask = tableSize - 1;
+    epoch = 1;
+    reindex();
+  }
+};
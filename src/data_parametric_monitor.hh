@@ -1,13 +1,17 @@
 #pragma once
 
 #include "automaton.hh"
+#include "compiled_automaton.hh"
 #include "observer.hh"
 #include "ppl_rational.hh"
+#include "ppl_thread_safety.hh"
 #include "subject.hh"
 #include "symbolic_number_constraint.hh"
+#include "symbolic_number_domain.hh"
 #include "symbolic_string_constraint.hh"
 #include "symbolic_update.hh"
 #include "timed_word_subject.hh"
+#include "zone.hh"
 
 namespace Parma_Polyhedra_Library {
   static inline std::size_t hash_value(const Symbolic::NumberValuation &p) {
@@ -15,7 +19,14 @@ namespace Parma_Polyhedra_Library {
   }
 } // namespace Parma_Polyhedra_Library
 
-#include <boost/unordered_set.hpp>
+#include "configuration_frontier.hh"
+#include "epsilon_closure.hh"
+#include "monitor_budget.hh"
+#include "thread_pool.hh"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
 
 struct DataParametricMonitorResult {
   std::size_t index;
@@ -24,167 +35,448 @@ struct DataParametricMonitorResult {
   Symbolic::StringValuation stringValuation;
 };
 
-class DataParametricMonitor : public SingleSubject<DataParametricMonitorResult>,
-                              public Observer<TimedWordEvent<PPLRational>> {
+/*!
+  @brief A configuration of DataParametricMonitor
+
+  @note The state is the index in the compiled automaton of the monitor.
+ */
+template <typename ClockValuation = TimingValuation, typename NumberValuation = Symbolic::NumberValuation>
+struct DataParametricConfiguration {
+  std::uint32_t state = 0;
+  ClockValuation clockValuation;
+  Symbolic::StringValuation stringEnv;
+  NumberValuation numberEnv;
+  //! @brief The absolute time of the last transition
+  double absTime = 0;
+  //! @brief The index of the event at which the partial match left an initial state. It is not compared.
+  std::size_t start = 0;
+
+  bool operator==(const DataParametricConfiguration &other) const {
+    return sameKey(other) && numberEnv == other.numberEnv;
+  }
+
+  //! @brief Returns if this configuration differs from the other at most in the number valuation.
+  [[nodiscard]] bool sameKey(const DataParametricConfiguration &other) const {
+    return state == other.state && absTime == other.absTime && clockValuation == other.clockValuation &&
+           stringEnv == other.stringEnv;
+  }
+
+  /*!
+    @brief Returns if this configuration differs from the other only in the number valuation, and its number valuation
+    contains the other's
+   */
+  [[nodiscard]] bool subsumes(const DataParametricConfiguration &other) const {
+    return sameKey(other) && numberEnv.contains(other.numberEnv);
+  }
+
+  [[nodiscard]] std::size_t approximateBytes() const {
+    return sizeof(DataParametricConfiguration) + externalMemoryInBytes(clockValuation) +
+           externalMemoryInBytes(stringEnv) + numberEnv.external_memory_in_bytes();
+  }
+
+  //! @brief The hash of the members compared by sameKey()
+  friend std::size_t hashKey(const DataParametricConfiguration &conf) {
+    std::size_t seed = conf.state;
+    boost::hash_combine(seed, conf.absTime);
+    hashClockValuation(seed, conf.clockValuation);
+    boost::hash_combine(seed, conf.stringEnv);
+    return seed;
+  }
+
+  friend std::size_t hash_value(const DataParametricConfiguration &conf) {
+    std::size_t seed = hashKey(conf);
+    boost::hash_combine(seed, conf.numberEnv);
+    return seed;
+  }
+};
+
+/*!
+  @tparam ClockValuation The domain of the clocks: TimingValuation for the concrete clock values, or Zone to merge the
+  configurations whose clocks are in the same zone after extrapolation
+  @tparam NumberValuation The domain of the number variables: Symbolic::NumberValuation (polyhedra) for any linear
+  guard and update, Symbolic::SharedNumberValuation (polyhedra shared by the configurations) for the same with one
+  thread, or Symbolic::BoxNumberValuation or Symbolic::OctagonNumberValuation, which are cheaper and exact if supports()
+  holds
+ */
+template <typename ClockValuation = TimingValuation, typename NumberValuation = Symbolic::NumberValuation>
+class BasicDataParametricMonitor : public SingleSubject<DataParametricMonitorResult>,
+                                   public Observer<TimedWordEvent<PPLRational>> {
 public:
   static const constexpr std::size_t unobservableActionID = 127;
-  explicit DataParametricMonitor(const DataParametricTA &automaton) : automaton(automaton) {
+  //! @brief If the monitor can use more than one thread and run apart from the printer, which needs PPL built with
+  //! thread safety.
+  static constexpr bool isThreadSafe = pplThreadSafe;
+  /*!
+    @param threads The number of the threads to expand the configurations. If it is more than one, large frontiers
+    are split into chunks expanded in parallel, and the results are merged in the order of the chunks. Therefore,
+    the matches are notified in the same order as the single-threaded monitor.
+    @param budget The budget of the configurations
+    @param guardMemo The options of the memo of the guards on the shared number valuations
+    @throws std::runtime_error If there are more than one threads and the number valuations are shared or PPL is not
+    built with thread safety
+
+    @note Each worker thread has its own Parma_Polyhedra_Library::Thread_Init, and no PPL object is accessed by more
+    than one thread at a time. This requires PPL built with thread safety, which is checked by CMake (pplThreadSafe).
+   */
+  explicit BasicDataParametricMonitor(const DataParametricTA &automaton, std::size_t threads = 1,
+                                      MonitorBudget budget = {}, GuardMemoOptions guardMemo = {})
+      : automaton(automaton), compiled(automaton), timingGuards(compileTimingGuards(automaton, compiled)),
+        maxConstants(computeMaxConstants(automaton, timingGuards)),
+        epsilonClosure(compiled, unobservableActionID),
+        numberDomain(automaton.numberVariableSize, guardMemo.capacity), budget(std::move(budget)),
+        guardMemo(std::move(guardMemo)) {
+    if (threads > 1 && !Symbolic::NumberDomain<NumberValuation>::isThreadSafe) {
+      throw std::runtime_error("DataParametricMonitor: the shared number valuations need a single thread");
+    }
+    if (threads > 1 && !isThreadSafe) {
+      throw std::runtime_error(
+          "DataParametricMonitor: more than one thread needs PPL built with thread safety (--enable-thread-safe)");
+    }
+    if (threads > 1) {
+      pool = std::make_unique<ThreadPool>(threads, makeThreadContext);
+    }
     configurations.clear();
-    // configurations.reserve(automaton.initialStates.size());
-    std::vector<double> initCVal(automaton.clockVariableSize);
+    ClockValuation initCVal(automaton.clockVariableSize);
     // by default, initSEnv is no violating set (variant)
     Symbolic::StringValuation initSEnv(automaton.stringVariableSize);
     // by default, initNEnv is the universe of dimension automaton.numberVariableSize
-    Symbolic::NumberValuation initNEnv(automaton.numberVariableSize);
-    for (const auto &initialState: automaton.initialStates) {
+    NumberValuation initNEnv(automaton.numberVariableSize);
+    for (const auto initialState: compiled.initialStates()) {
       configurations.insert({initialState, initCVal, initSEnv, initNEnv, 0});
     }
   }
 
-  virtual ~DataParametricMonitor() {
+  //! @brief Returns if the number domain represents all the number guards and updates of the automaton exactly.
+  static bool supports(const DataParametricTA &automaton) {
+    const Symbolic::NumberDomain<NumberValuation> numberDomain(automaton.numberVariableSize);
+    const CompiledAutomaton<DataParametricTAState> compiled(automaton);
+    const auto edges = compiled.allEdges();
+    return std::all_of(edges.begin(), edges.end(), [&numberDomain](const auto &edge) {
+      return numberDomain.isExact(edge.transition.numConstraints, edge.transition.update);
+    });
+  }
+
+  //! @brief Initialize PPL in a thread other than the main thread using this monitor, e.g., a worker thread.
+  static std::shared_ptr<void> makeThreadContext() {
+    return std::make_shared<Parma_Polyhedra_Library::Thread_Init>();
+  }
+
+  //! @brief Returns the numbers of the guards whose results are memoized and computed.
+  [[nodiscard]] GuardMemoCounters guardMemoCounters() const {
+    return numberDomain.guardMemoCounters();
+  }
+
+  virtual ~BasicDataParametricMonitor() {
+    numberDomain.beginEvent();
     epsilonTransition(configurations);
+    if (guardMemo.counters) {
+      *guardMemo.counters += guardMemoCounters();
+    }
   }
 
   void notify(const TimedWordEvent<PPLRational> &event) override {
-    const Action actionId = event.actionId;
-    const std::vector<std::string> &strings = event.strings;
-    const std::vector<PPLRational> &numbers = event.numbers;
-    const double timestamp = event.timestamp;
-
-    boost::unordered_set<Configuration> nextConfigurations;
-    configurations.merge(epsilonTransition(configurations));
+    numberDomain.beginEvent();
+    epsilonTransition(configurations);
+    nextConfigurations.clear();
 
-    for (const Configuration &conf: configurations) {
-      // make the current env
-      auto clockValuation = std::get<1>(conf); //.clockValuation;
-      const auto absTime = std::get<4>(conf);
-      if (timestamp < absTime) {
-        continue;
-      }
-      for (double &d: clockValuation) {
-        d += timestamp - absTime;
-      }
-      auto stringEnv = std::get<2>(conf); //.stringEnv;
-      stringEnv.insert(stringEnv.end(), strings.begin(), strings.end());
-      auto numberEnv = std::get<3>(conf); //.numberEnv;
-      // add dimension for the data in the timed word.
-      assert(numberEnv.space_dimension() == automaton.numberVariableSize);
-      numberEnv.add_space_dimensions_and_embed(numbers.size());
-      for (std::size_t i = 0; i < numbers.size(); i++) {
-        numberEnv.add_constraint(Parma_Polyhedra_Library::Variable(automaton.numberVariableSize + i) * numbers[i].getDenominator() == numbers[i].getNumerator());
+    const std::size_t size = configurations.size();
+    if (!pool || size < 2 * minimumChunkSize) {
+      const auto scratch = [this]() -> Configuration & { return nextConfigurations.scratch(); };
+      const auto commit = [this](const Configuration &nextConf, bool isMatch) {
+        if (isMatch) {
+          this->notifyObservers(
+              {index, nextConf.absTime, numberDomain.toPolyhedron(nextConf.numberEnv), nextConf.stringEnv});
+        }
+        nextConfigurations.commit();
+      };
+      for (const Configuration &conf: configurations) {
+        expand(conf, event, buffers.front(), scratch, commit);
       }
-
-      auto transitionIt = std::get<0>(conf)->next.find(actionId);
-      if (transitionIt == std::get<0>(conf)->next.end()) {
-        continue;
+    } else {
+      const std::size_t chunkSize = std::max(minimumChunkSize, size / (pool->size() * chunksPerThread) + 1);
+      const std::size_t chunks = (size + chunkSize - 1) / chunkSize;
+      if (buffers.size() < chunks) {
+        buffers.resize(chunks);
       }
-      for (const auto &transition: transitionIt->second) {
-        // evaluate the guards
-        auto nextSEnv = stringEnv;
-        auto nextNEnv = numberEnv;
-        if (eval(clockValuation, transition.guard) &&
-            eval(transition.stringConstraints, nextSEnv, transition.numConstraints, nextNEnv)) {
-          auto nextCVal = clockValuation;
-          for (const VariableID resetVar: transition.resetVars) {
-            nextCVal[resetVar] = 0;
-          }
-          transition.update.execute(nextSEnv, nextNEnv);
-          nextSEnv.resize(automaton.stringVariableSize);
-          nextNEnv.remove_higher_space_dimensions(automaton.numberVariableSize);
-          nextConfigurations.insert({transition.target.lock(), std::move(nextCVal), nextSEnv, nextNEnv, timestamp});
-          if (transition.target.lock()->isMatch) {
-            notifyObservers({index, timestamp, nextNEnv, nextSEnv});
+      pool->parallelFor(chunks, [&](std::size_t chunk) {
+        Expansion &buffer = buffers[chunk];
+        buffer.size = 0;
+        const auto scratch = [&buffer]() -> Configuration & { return buffer.scratch(); };
+        const auto commit = [&buffer](const Configuration &, bool isMatch) { buffer.commit(isMatch); };
+        const std::size_t end = std::min(size, (chunk + 1) * chunkSize);
+        for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+          expand(configurations[i], event, buffer, scratch, commit);
+        }
+      });
+      // Merge the successors in the order of the chunks, which is the order of the sequential expansion.
+      for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        Expansion &buffer = buffers[chunk];
+        for (std::size_t i = 0; i < buffer.size; ++i) {
+          Configuration &nextConf = buffer.successors[i];
+          if (buffer.isMatch[i]) {
+            this->notifyObservers(
+                {index, nextConf.absTime, numberDomain.toPolyhedron(nextConf.numberEnv), nextConf.stringEnv});
           }
+          // We swap instead of copying so that both buffers keep recycled storage.
+          std::swap(nextConfigurations.scratch(), nextConf);
+          nextConfigurations.commit();
         }
       }
     }
     index++;
-    configurations = std::move(nextConfigurations);
+    // The successors and the matches of a subsumed configuration are subsumed by those of the configuration subsuming
+    // it, so only the maximal ones are kept.
+    nextConfigurations.removeSubsumed([](const Configuration &conf) { return hashKey(conf); },
+                                      [](const Configuration &left, const Configuration &right) {
+                                        return left.subsumes(right);
+                                      });
+    std::swap(configurations, nextConfigurations);
+    enforceBudget();
+  }
+
+  //! @brief Process the events in order without the virtual dispatch per event.
+  void notifyBatch(const TimedWordEvent<PPLRational> *events, std::size_t size) override {
+    for (std::size_t i = 0; i < size; ++i) {
+      BasicDataParametricMonitor::notify(events[i]);
+    }
   }
 
 private:
   const DataParametricTA automaton;
-  using Configuration = std::tuple<std::shared_ptr<DataParametricTAState>, std::vector<double>,
-                                   Symbolic::StringValuation, Symbolic::NumberValuation, double>;
-  // Symbolic::NumberValuation>;
-  /*  struct Configuration {
-      std::shared_ptr<DataParametricTAState> state;
-      std::vector<double> clockValuation;
-      NonSymbolic::StringValuation stringEnv;
-      Symbolic::NumberValuation numberEnv;
-    };*/
-  boost::unordered_set<Configuration> configurations;
+  //! @brief The automaton taken by the configurations, which refer to their state by the index
+  const CompiledAutomaton<DataParametricTAState> compiled;
+  //! @brief The timing guard of each edge normalized to the bounds of the clocks, indexed by compiled.edgeIndex
+  const std::vector<TimingBounds> timingGuards;
+  //! @brief The largest constant compared with each clock, used to extrapolate the zones
+  const std::vector<double> maxConstants;
+  //! @brief The unobservable transitions. If it is empty, we skip the epsilon transitions.
+  const EpsilonClosure<DataParametricTAState> epsilonClosure;
+  const Symbolic::NumberDomain<NumberValuation> numberDomain;
+  const MonitorBudget budget;
+  const GuardMemoOptions guardMemo;
+  using Configuration = DataParametricConfiguration<ClockValuation, NumberValuation>;
+  //! @brief A chunk with fewer configurations is not worth a task. The polyhedral operations make each one heavy.
+  static constexpr std::size_t minimumChunkSize = 16;
+  //! @brief We make more chunks than threads to balance the load.
+  static constexpr std::size_t chunksPerThread = 4;
+
+  /*!
+    @brief The working storage to expand configurations, which is recycled across events
+
+    In the parallel mode, each chunk has its own Expansion holding its successors.
+   */
+  struct Expansion {
+    //! @brief The buffers of the valuations extended with the current event
+    ClockValuation clockValuation;
+    Symbolic::StringValuation stringEnv;
+    NumberValuation numberEnv;
+    //! @brief The first size elements are the successors in the order of the expansion.
+    std::vector<Configuration> successors;
+    //! @brief If isMatch[i] is true, successors[i] is at an accepting state.
+    std::vector<bool> isMatch;
+    std::size_t size = 0;
+
+    Configuration &scratch() {
+      if (size == successors.size()) {
+        successors.emplace_back();
+        isMatch.push_back(false);
+      }
+      return successors[size];
+    }
+    void commit(bool match) {
+      isMatch[size++] = match;
+    }
+  };
+
+  /*!
+    @throws std::runtime_error If a guard refers to an undefined clock variable.
+   */
+  static std::vector<TimingBounds> compileTimingGuards(const DataParametricTA &automaton,
+                                                       const CompiledAutomaton<DataParametricTAState> &compiled) {
+    std::vector<TimingBounds> guards;
+    guards.reserve(compiled.allEdges().size());
+    for (const auto &edge: compiled.allEdges()) {
+      guards.emplace_back(edge.transition.guard);
+      if (guards.back().clockSize() > automaton.clockVariableSize) {
+        throw std::runtime_error("A guard refers to an undefined clock variable");
+      }
+    }
+    return guards;
+  }
+
+  static std::vector<double> computeMaxConstants(const DataParametricTA &automaton,
+                                                 const std::vector<TimingBounds> &timingGuards) {
+    std::vector<double> maxConstants(automaton.clockVariableSize, -std::numeric_limits<double>::infinity());
+    for (const TimingBounds &guard: timingGuards) {
+      guard.updateMaxConstants(maxConstants);
+    }
+    return maxConstants;
+  }
+
+  /*!
+    @brief The configurations before and after the current event
+
+    Both frontiers persist across events and are swapped after each event so that their storage is recycled.
+   */
+  ConfigurationFrontier<Configuration> configurations, nextConfigurations;
+  //! @brief The buffers of the expansion. The first one is used in the sequential mode.
+  std::vector<Expansion> buffers = std::vector<Expansion>(1);
+  std::unique_ptr<ThreadPool> pool;
   std::size_t index = 0;
 
+  /*!
+    @brief Compute the successors of a configuration by the given event.
+
+    @param scratch A function returning the storage of the next successor.
+    @param commit A function called with each successor and whether it is at an accepting state.
+    @note This function is called concurrently in the parallel mode. It must not modify the monitor.
+   */
+  template <typename Scratch, typename Commit>
+  void expand(const Configuration &conf, const TimedWordEvent<PPLRational> &event, Expansion &buffer,
+              const Scratch &scratch, const Commit &commit) const {
+    const auto edges = compiled.edges(conf.state, event.actionId);
+    if (edges.empty() || event.timestamp < conf.absTime) {
+      return;
+    }
+    const std::vector<PPLRational> &numbers = event.numbers;
+    // make the current env
+    buffer.clockValuation = conf.clockValuation;
+    elapse(buffer.clockValuation, event.timestamp - conf.absTime);
+    // We discard all the edges at once if no timing guard holds after the dwell time.
+    if (std::none_of(edges.begin(), edges.end(), [&](const auto &edge) {
+          return intersects(buffer.clockValuation, timingGuards[compiled.edgeIndex(edge)]);
+        })) {
+      return;
+    }
+    buffer.stringEnv = conf.stringEnv;
+    buffer.stringEnv.insert(buffer.stringEnv.end(), event.strings.begin(), event.strings.end());
+    buffer.numberEnv = conf.numberEnv;
+    // add dimension for the data in the timed word.
+    numberDomain.embed(buffer.numberEnv, numbers);
+
+    for (const auto &edge: edges) {
+      const auto &[transition, target] = edge;
+      const TimingBounds &timingGuard = timingGuards[compiled.edgeIndex(edge)];
+      if (!intersects(buffer.clockValuation, timingGuard)) {
+        continue;
+      }
+      // evaluate the guards
+      Configuration &nextConf = scratch();
+      nextConf.stringEnv = buffer.stringEnv;
+      nextConf.numberEnv = buffer.numberEnv;
+      if (numberDomain.eval(transition.stringConstraints, nextConf.stringEnv, transition.numConstraints,
+                            nextConf.numberEnv, numbers)) {
+        nextConf.clockValuation = buffer.clockValuation;
+        if (!constrain(nextConf.clockValuation, timingGuard)) {
+          continue;
+        }
+        nextConf.state = target;
+        nextConf.absTime = event.timestamp;
+        nextConf.start = compiled.isInitial(conf.state) ? index : conf.start;
+        for (const VariableID resetVar: transition.resetVars) {
+          reset(nextConf.clockValuation, resetVar);
+        }
+        extrapolate(nextConf.clockValuation, maxConstants);
+        numberDomain.execute(transition.update, nextConf.stringEnv, nextConf.numberEnv, numbers);
+        nextConf.stringEnv.resize(automaton.stringVariableSize);
+        numberDomain.project(nextConf.numberEnv);
+        commit(nextConf, compiled.isMatch(target));
+      }
+    }
+  }
+
+  /*!
+    @brief Apply the policy of the budget if the configurations after the current event exceed the budget.
+    @throws std::runtime_error If the policy is BudgetPolicy::Abort, or if the configurations still exceed the budget
+    after BudgetPolicy::Merge
+   */
+  void enforceBudget() {
+    budget.record(configurations.size());
+    if (!budget.limits()) {
+      return;
+    }
+    std::vector<std::size_t> bytes = budget.measure(configurations);
+    if (budget.allows(configurations.size(), MonitorBudget::total(bytes))) {
+      return;
+    }
+    budget.exceed(index, configurations.size(), MonitorBudget::total(bytes));
+    if (budget.policy == BudgetPolicy::Drop) {
+      budget.dropOldest(index, configurations, bytes, [this](const Configuration &conf) {
+        return compiled.isInitial(conf.state) ? MonitorBudget::initialStart : conf.start;
+      });
+      return;
+    }
+    const std::size_t merged = configurations.mergeGroups(
+        [](const Configuration &conf) { return hashKey(conf); },
+        [](const Configuration &left, const Configuration &right) { return left.sameKey(right); },
+        [](Configuration &left, const Configuration &right) {
+          left.numberEnv.upper_bound_assign(right.numberEnv);
+          left.start = std::min(left.start, right.start);
+        });
+    if (budget.counters) {
+      budget.counters->merged += merged;
+    }
+    bytes = budget.measure(configurations);
+    if (!budget.allows(configurations.size(), MonitorBudget::total(bytes))) {
+      MonitorBudget::fail(index, configurations.size(), MonitorBudget::total(bytes));
+    }
+  }
+
   /**
    * Performs epsilon (unobservable) transitions starting from the given configurations.
    *
-   * This method repeatedly explores transitions labeled with the unobservable action
-   * from all current configurations, advancing time according to clock guards,
-   * applying clock resets and symbolic updates, and collecting all reachable
-   * configurations. Exploration continues until no further epsilon transitions
-   * are possible. Whenever a target state marked as a match is reached,
+   * This method explores transitions labeled with the unobservable action
+   * from all configurations in the frontier, advancing time according to clock guards,
+   * applying clock resets and symbolic updates, and appending the reached
+   * configurations to the frontier itself. Since the frontier is also the worklist,
+   * the exploration continues until no new configuration is reachable.
+   * Whenever a target state marked as a match is reached,
    * it notifies registered observers using the current index, absolute time, and valuations.
    *
-   * @param currentConfigurations
-   *        The initial set of configurations from which epsilon transitions
-   *        are taken. The set is passed by value and moved into an internal
-   *        worklist; it should not be used by the caller after this call.
-   *
-   * @return The set of configurations reachable via zero or more epsilon
-   *         transitions that cannot be further extended by additional epsilon
-   *         transitions.
-   *
+   * @param frontier
+   *        The configurations from which epsilon transitions are taken.
+   *        After this call, it also contains the configurations reachable
+   *        via one or more epsilon transitions.
    */
-  boost::unordered_set<Configuration> epsilonTransition(boost::unordered_set<Configuration> currentConfigurations) {
-    // the next configurations to explore
-    boost::unordered_set<Configuration> nextConfigurations;
-    // the configurations reachable via epsilon transitions
-    boost::unordered_set<Configuration> returnConfigurations;
-
-    while (!currentConfigurations.empty()) {
-      nextConfigurations.clear();
-      for (const Configuration &conf: currentConfigurations) {
-        auto transitionIt = std::get<0>(conf)->next.find(unobservableActionID);
-        if (transitionIt == std::get<0>(conf)->next.end()) {
-          continue;
-        }
+  void epsilonTransition(ConfigurationFrontier<Configuration> &frontier) {
+    if (epsilonClosure.empty()) {
+      return;
+    }
+    for (std::size_t i = 0; i < frontier.size(); ++i) {
+      for (const auto &[edge, equalities]: epsilonClosure.edges(frontier[i].state)) {
+        const auto &[transition, target] = *edge;
+        // scratch() may move the configurations. We must take conf after it.
+        Configuration &nextConf = frontier.scratch();
+        const Configuration &conf = frontier[i];
+        const auto df = diff(conf.clockValuation, equalities);
+        if (!df) continue;
         // make the current env
-        const auto clockValuation = std::get<1>(conf);
-        const auto stringEnv = std::get<2>(conf);
-        const auto numberEnv = std::get<3>(conf);
-        for (const auto &transition: transitionIt->second) {
-          // evaluate the guards
-          auto nextCVal = clockValuation;
-          auto nextSEnv = stringEnv;
-          auto nextNEnv = numberEnv;
-          auto extendedGuard = transition.guard;
-          
-          auto absTime = std::get<4>(conf);
-          auto df = diff(nextCVal, extendedGuard);
-          if (!df) continue;
-          for (double &d: nextCVal) {
-            d += df.value();
+        nextConf.clockValuation = conf.clockValuation;
+        elapse(nextConf.clockValuation, df.value());
+        nextConf.stringEnv = conf.stringEnv;
+        nextConf.numberEnv = conf.numberEnv;
+
+        // evaluate the guards
+        if (constrain(nextConf.clockValuation, timingGuards[compiled.edgeIndex(*edge)]) &&
+            numberDomain.eval(transition.stringConstraints, nextConf.stringEnv, transition.numConstraints,
+                              nextConf.numberEnv, {})) {
+          nextConf.state = target;
+          nextConf.absTime = conf.absTime + df.value();
+          nextConf.start = compiled.isInitial(conf.state) ? index : conf.start;
+          for (const VariableID resetVar: transition.resetVars) {
+            reset(nextConf.clockValuation, resetVar);
           }
-          absTime += df.value();
-
-          if (eval(nextCVal, extendedGuard) &&
-              eval(transition.stringConstraints, nextSEnv, transition.numConstraints, nextNEnv)) {
-            for (const VariableID resetVar: transition.resetVars) {
-              nextCVal[resetVar] = 0;
-            }
-            auto nextState = transition.target.lock();
-            transition.update.execute(nextSEnv, nextNEnv);
-            nextConfigurations.insert({nextState, nextCVal, nextSEnv, nextNEnv, absTime});
-            returnConfigurations.insert({nextState, nextCVal, nextSEnv, nextNEnv, absTime});
-            if (nextState->isMatch) {
-              this->notifyObservers({index, absTime, nextNEnv, nextSEnv});
-            }
+          extrapolate(nextConf.clockValuation, maxConstants);
+          numberDomain.execute(transition.update, nextConf.stringEnv, nextConf.numberEnv, {});
+          if (compiled.isMatch(target)) {
+            this->notifyObservers(
+                {index, nextConf.absTime, numberDomain.toPolyhedron(nextConf.numberEnv), nextConf.stringEnv});
           }
+          frontier.commit();
         }
       }
-      std::swap(currentConfigurations, nextConfigurations);
     }
-    return returnConfigurations;
   }
 };
+
+using DataParametricMonitor = BasicDataParametricMonitor<>;
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "compiled_automaton.hh"
+#include "timing_constraint.hh"
+
+/*!
+  @brief The unobservable transitions of a compiled automaton prepared once for the epsilon closures of the monitors
+
+  A monitor takes an unobservable transition after the delay making all of its equalities x == c hold (see diff()).
+  The equalities of each transition are checked and normalized here once instead of for each configuration: each clock
+  appears at most once, and the transitions whose equalities contradict each other are omitted because they are never
+  enabled. The transitions are grouped by their source state, so the epsilon closure does nothing for a configuration
+  at a state without them.
+
+  @note The edges refer to the compiled automaton, which must outlive this.
+  @tparam State The AutomatonState, whose guards are conjunctions of TimingConstraint
+ */
+template <typename State> class EpsilonClosure {
+public:
+  using Compiled = CompiledAutomaton<State>;
+  using StateIndex = typename Compiled::StateIndex;
+
+  //! @brief An unobservable edge with its normalized equalities
+  struct DelayedEdge {
+    const typename Compiled::Edge *edge;
+    //! @brief The equalities sorted by the clock
+    std::vector<TimingConstraint> equalities;
+  };
+
+  //! @brief The contiguous unobservable edges of a state
+  class DelayedEdgeRange {
+  public:
+    DelayedEdgeRange(const DelayedEdge *first, const DelayedEdge *last) : first(first), last(last) {
+    }
+    [[nodiscard]] const DelayedEdge *begin() const {
+      return first;
+    }
+    [[nodiscard]] const DelayedEdge *end() const {
+      return last;
+    }
+
+  private:
+    const DelayedEdge *first, *last;
+  };
+
+  EpsilonClosure() = default;
+
+  /*!
+    @throws std::runtime_error If an unobservable transition has a timing constraint other than an equality.
+   */
+  EpsilonClosure(const Compiled &compiled, Action unobservableAction) {
+    offsets.reserve(compiled.stateSize() + 1);
+    offsets.push_back(0);
+    for (StateIndex state = 0; state < compiled.stateSize(); ++state) {
+      for (const auto &edge: compiled.edges(state, unobservableAction)) {
+        if (auto equalities = normalize(edge.transition.guard)) {
+          delayedEdges.push_back({&edge, std::move(*equalities)});
+        }
+      }
+      offsets.push_back(delayedEdges.size());
+    }
+  }
+
+  //! @brief Returns if there are no unobservable transitions that may be enabled.
+  [[nodiscard]] bool empty() const {
+    return delayedEdges.empty();
+  }
+
+  //! @brief Returns the unobservable transitions from the state.
+  [[nodiscard]] DelayedEdgeRange edges(StateIndex state) const {
+    return {delayedEdges.data() + offsets[state], delayedEdges.data() + offsets[state + 1]};
+  }
+
+private:
+  std::vector<DelayedEdge> delayedEdges;
+  //! @brief The edges of the state s are delayedEdges[offsets[s], offsets[s + 1]).
+  std::vector<std::uint32_t> offsets;
+
+  /*!
+    @returns The equalities sorted by the clock without duplicates, or std::nullopt if they contradict each other
+    @throws std::runtime_error If a non-equality constraint is present
+   */
+  static std::optional<std::vector<TimingConstraint>> normalize(std::vector<TimingConstraint> guard) {
+    for (const TimingConstraint &constraint: guard) {
+      if (constraint.odr != TimingConstraint::Order::eq) {
+        throw std::runtime_error(
+            "TimingConstraint: unsupported guard with inequality constraints on unobservable transition");
+      }
+    }
+    std::sort(guard.begin(), guard.end(), [](const TimingConstraint &left, const TimingConstraint &right) {
+      return left.x < right.x || (left.x == right.x && left.c < right.c);
+    });
+    for (std::size_t i = 1; i < guard.size(); ++i) {
+      if (guard[i - 1].x == guard[i].x && guard[i - 1].c != guard[i].c) {
+        return std::nullopt;
+      }
+    }
+    guard.erase(std::unique(guard.begin(), guard.end(),
+                            [](const TimingConstraint &left, const TimingConstraint &right) {
+                              return left.x == right.x;
+                            }),
+                guard.end());
+    return guard;
+  }
+};
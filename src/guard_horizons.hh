@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "compiled_automaton.hh"
+#include "timing_constraint.hh"
+
+/*!
+  @brief The largest value of each clock at each state from which an accepting state may be reachable
+
+  A clock only grows until it is reset. Therefore, if every path from the state q to an accepting state takes an edge
+  whose guard bounds the clock x from above by c before x is reset, a configuration at q with x > c never matches
+  again. For example, the clock of `within (< 5) { ... }` (see timeRestriction()) is never reset, and thus the
+  configurations where it exceeds 5 are dead.
+
+  The horizons are the least fixpoint of the backward propagation of the upper bounds over the edges of the compiled
+  automaton. Since they ignore the lower bounds of the guards and the string and number guards, they are
+  over-approximations: a configuration beyond a horizon is dead, but a configuration within the horizons may be dead.
+ */
+class GuardHorizons {
+public:
+  using Timestamp = TimingConstraint::Timestamp;
+  using StateIndex = std::uint32_t;
+
+  //! @brief An upper bound of a clock meaning "< value" if strict and "<= value" otherwise
+  struct Horizon {
+    Timestamp value;
+    bool strict;
+
+    static constexpr Horizon infinity() {
+      return {std::numeric_limits<Timestamp>::infinity(), false};
+    }
+    bool operator<(const Horizon &other) const {
+      return value < other.value || (value == other.value && strict && !other.strict);
+    }
+    bool operator==(const Horizon &other) const {
+      return value == other.value && strict == other.strict;
+    }
+  };
+
+  GuardHorizons() = default;
+
+  /*!
+    @param timingGuard A function returning the TimingBounds of the edge of the given index in compiled.allEdges()
+   */
+  template <typename State, typename TimingGuard>
+  GuardHorizons(const CompiledAutomaton<State> &compiled, std::size_t clockSize, TimingGuard timingGuard)
+      : clockSize(clockSize), live(compiled.stateSize(), false), bounded(compiled.stateSize(), false),
+        horizons(compiled.stateSize() * clockSize, Horizon{-std::numeric_limits<Timestamp>::infinity(), false}) {
+    for (bool changed = true; changed;) {
+      changed = false;
+      for (StateIndex state = 0; state < compiled.stateSize(); ++state) {
+        for (const auto &edge: compiled.edgesFrom(state)) {
+          const TimingBounds &guard = timingGuard(compiled.edgeIndex(edge));
+          const bool accepting = compiled.isMatch(edge.target);
+          if (!guard.isSatisfiable() || (!accepting && !live[edge.target])) {
+            continue;
+          }
+          changed |= !live[state];
+          live[state] = true;
+          const auto &resetVars = edge.transition.resetVars;
+          for (std::size_t x = 0; x < clockSize; ++x) {
+            // The clock at the source is at most its value when the edge is taken, which is at most its value at the
+            // target unless it is reset.
+            Horizon bound = Horizon::infinity();
+            if (!accepting && std::find(resetVars.begin(), resetVars.end(), x) == resetVars.end()) {
+              bound = horizon(edge.target, x);
+            }
+            for (const TimingBounds::Bound &clockBound: guard.clockBounds()) {
+              if (clockBound.x == x) {
+                bound = std::min(bound, Horizon{clockBound.upper, clockBound.upperStrict});
+              }
+            }
+            if (horizon(state, x) < bound) {
+              horizons[state * clockSize + x] = bound;
+              changed = true;
+            }
+          }
+        }
+      }
+    }
+    for (StateIndex state = 0; state < compiled.stateSize(); ++state) {
+      for (std::size_t x = 0; x < clockSize; ++x) {
+        bounded[state] = bounded[state] || horizon(state, x) < Horizon::infinity();
+      }
+    }
+  }
+
+  //! @brief Returns the upper bound of the clock x at the state beyond which no accepting state is reachable.
+  [[nodiscard]] const Horizon &horizon(StateIndex state, std::size_t x) const {
+    return horizons[state * clockSize + x];
+  }
+
+  /*!
+    @brief Returns false if a configuration at the state with the clock valuation never reaches an accepting state.
+
+    @tparam ClockValuation TimingValuation or Zone, with clockLowerBound()
+   */
+  template <typename ClockValuation>
+  [[nodiscard]] bool isLive(StateIndex state, const ClockValuation &clockValuation) const {
+    if (!live[state]) {
+      return false;
+    }
+    if (!bounded[state]) {
+      return true;
+    }
+    for (std::size_t x = 0; x < clockSize; ++x) {
+      const auto [lower, lowerStrict] = clockLowerBound(clockValuation, x);
+      const Horizon &upper = horizon(state, x);
+      if (upper.value < lower || (upper.value == lower && (upper.strict || lowerStrict))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  std::size_t clockSize = 0;
+  //! @brief live[q] is false if no accepting state is reachable from the state q by one or more edges.
+  std::vector<bool> live;
+  //! @brief bounded[q] is true if the state q has a finite horizon.
+  std::vector<bool> bounded;
+  //! @brief horizons[q * clockSize + x] is the horizon of the clock x at the state q.
+  std::vector<Horizon> horizons;
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <boost/functional/hash.hpp>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include <ppl.hh>
+
+/*!
+  @brief Returns a hash of the polyhedron that is the same for equal polyhedra in most cases.
+
+  Unlike NNC_Polyhedron::hash_code(), which only depends on the dimension, this hashes the minimized constraints. The
+  hashes of the constraints are summed because their order is not canonical. Since the minimized constraints are not
+  canonical either, equal polyhedra may have different fingerprints, which only makes GuardMemo miss.
+ */
+inline std::size_t fingerprint(const Parma_Polyhedra_Library::NNC_Polyhedron &polyhedron) {
+  std::size_t result = 0;
+  for (const auto &constraint: polyhedron.minimized_constraints()) {
+    std::size_t seed = constraint.is_equality() ? 0 : constraint.is_strict_inequality() ? 1 : 2;
+    boost::hash_combine(seed, std::hash<Parma_Polyhedra_Library::Coefficient>{}(constraint.inhomogeneous_term()));
+    for (std::size_t i = 0; i < constraint.space_dimension(); ++i) {
+      boost::hash_combine(seed, std::hash<Parma_Polyhedra_Library::Coefficient>{}(
+                                    constraint.coefficient(Parma_Polyhedra_Library::Variable(i))));
+    }
+    result += seed;
+  }
+  boost::hash_combine(result, polyhedron.space_dimension());
+  return result;
+}
+
+//! @brief The numbers of the lookups of GuardMemo using and not using a memoized result
+struct GuardMemoCounters {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+
+  GuardMemoCounters &operator+=(const GuardMemoCounters &other) {
+    hits += other.hits;
+    misses += other.misses;
+    return *this;
+  }
+};
+
+/*!
+  @brief The options of the memos of the guards of a symbolic monitor
+
+  The memo is disabled by default. A lookup computes the fingerprint and compares the polyhedra, and a miss copies the
+  polyhedron twice, which pays off only if the same guard is often applied to the same polyhedron.
+ */
+struct GuardMemoOptions {
+  //! @brief The maximum number of the memoized results of each thread, or zero for no memo
+  std::size_t capacity = 0;
+  //! @brief If given, the monitor adds the lookups of its memos when it is destroyed. They outlive the monitor.
+  std::shared_ptr<GuardMemoCounters> counters;
+};
+
+/*!
+  @brief A least-recently-used memo of the results of the guards on the polyhedra
+
+  The intersection with a guard and the emptiness check are the most expensive operations of the symbolic monitors,
+  and the same guard is often applied to the same polyhedron, e.g., for the configurations differing only in the
+  string valuation, or for the events with the same data. The memo maps a pair of the fingerprint of a polyhedron and
+  a transition to the polyhedron and the result of the guard. A memoized result is used only if the polyhedron is
+  equal to the memoized one, so a collision of the fingerprints only costs a miss.
+
+  @note This is not thread-safe. Each thread must use its own memo.
+  @tparam Polyhedron A polyhedron with operator== and fingerprint()
+  @tparam Transition The identity of the guard, e.g., the index of the edge
+ */
+template <typename Polyhedron, typename Transition = std::size_t> class GuardMemo {
+public:
+  static constexpr std::size_t defaultCapacity = 1024;
+
+  //! @param capacity The maximum number of the memoized results. If it is zero, nothing is memoized.
+  explicit GuardMemo(std::size_t capacity = defaultCapacity) : capacity(capacity) {
+  }
+
+  //! @brief A copy has the same capacity and starts empty because the index refers to the entries of the original.
+  GuardMemo(const GuardMemo &other) : GuardMemo(other.capacity) {
+  }
+
+  GuardMemo &operator=(const GuardMemo &other) {
+    capacity = other.capacity;
+    clear();
+    return *this;
+  }
+
+  /*!
+    @brief Replace the polyhedron with the result of the guard of the transition, which is memoized.
+
+    @param compute A function applying the guard to a polyhedron and returning false if the result is empty
+    @returns false if the result is empty. Then, the polyhedron is unspecified.
+   */
+  template <typename Compute> bool apply(Polyhedron &polyhedron, const Transition &transition, const Compute &compute) {
+    if (capacity == 0) {
+      return compute(polyhedron);
+    }
+    const Key key{fingerprint(polyhedron), transition};
+    if (const auto it = index.find(key); it != index.end()) {
+      if (it->second->input == polyhedron) {
+        ++counters.hits;
+        entries.splice(entries.begin(), entries, it->second);
+        if (!it->second->result) {
+          return false;
+        }
+        polyhedron = *it->second->result;
+        return true;
+      }
+      entries.erase(it->second);
+      index.erase(it);
+    }
+    ++counters.misses;
+    entries.push_front(Entry{key, polyhedron, std::nullopt});
+    index.emplace(key, entries.begin());
+    if (compute(polyhedron)) {
+      entries.front().result = polyhedron;
+    }
+    if (entries.size() > capacity) {
+      index.erase(entries.back().key);
+      entries.pop_back();
+    }
+    return entries.front().result.has_value();
+  }
+
+  //! @brief Forget all the memoized results. The counters are kept.
+  void clear() {
+    entries.clear();
+    index.clear();
+  }
+
+  [[nodiscard]] std::size_t size() const {
+    return entries.size();
+  }
+
+  [[nodiscard]] const GuardMemoCounters &getCounters() const {
+    return counters;
+  }
+
+private:
+  using Key = std::pair<std::size_t, Transition>;
+  struct Entry {
+    Key key;
+    Polyhedron input;
+    //! @brief The result of the guard, or std::nullopt if it is empty
+    std::optional<Polyhedron> result;
+  };
+
+  std::size_t capacity;
+  //! @brief The memoized results from the most recently used one
+  std::list<Entry> entries;
+  std::unordered_map<Key, typename std::list<Entry>::iterator, boost::hash<Key>> index;
+  GuardMemoCounters counters;
+};
@@ -34,7 +34,7 @@ namespace NonSymbolic {
       case '\'': {
         std::string str;
         if (std::getline(is, str, '\'')) {
-          atom.value = std::move(str);
+          atom.value = InternedString(str);
         } else {
           is.unget();
           is.setstate(std::ios_base::failbit);
@@ -384,7 +384,7 @@ namespace Symbolic {
       case '\'': {
         std::string str;
         if (std::getline(is, str, '\'')) {
-          atom.value = std::move(str);
+          atom.value = InternedString(str);
         } else {
           is.unget();
           is.setstate(std::ios_base::failbit);
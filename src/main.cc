@@ -7,9 +7,13 @@
 
 #include "boolean_monitor.hh"
 #include "data_parametric_monitor.hh"
+#include "mmap_timed_word_parser.hh"
+#include "monitor_budget.hh"
 #include "parametric_monitor.hh"
+#include "pipeline.hh"
 #include "ppl_rational.hh"
 #include "printer.hh"
+#include "string_pool.hh"
 
 using namespace boost::program_options;
 using namespace boost;
@@ -26,18 +30,144 @@ using NonSymbolic::operator<<;
 using std::operator<<;
 using ::operator<<;
 
+//! @brief The capacity of each queue between the threads of the pipeline
+static constexpr std::size_t pipelineCapacity = 4096;
+
+//! @brief Print the counters of the budget to the standard error if the budget was exceeded.
+static void reportBudget(const MonitorBudget &budget) {
+  if (!budget.counters || budget.counters->exceeded == 0) {
+    return;
+  }
+  const BudgetCounters &counters = *budget.counters;
+  std::cerr << "SyMon: the configuration budget was exceeded " << counters.exceeded << " times ("
+            << counters.dropped << " configurations dropped, " << counters.merged << " merged, at most "
+            << counters.peakConfigurations << " configurations)" << std::endl;
+  std::cerr << "SyMon: the string pool, which is not bounded by the budget, holds " << StringPool::global().size()
+            << " strings (about " << StringPool::global().memoryInBytes() << " bytes)" << std::endl;
+}
+
+//! @brief Print the counters of the guard memos to the standard error if they are requested.
+static void reportGuardMemo(const GuardMemoOptions &guardMemo) {
+  if (!guardMemo.counters) {
+    return;
+  }
+  const GuardMemoCounters &counters = *guardMemo.counters;
+  std::cerr << "SyMon: the memoized results of the guards were used " << counters.hits << " times and computed "
+            << counters.misses << " times (capacity " << guardMemo.capacity << ")" << std::endl;
+}
+
+/*!
+ * @brief Monitor the timed word by the automaton
+ *
+ * @param [in] TA the automaton
+ * @param [in] signature the signature of the timed word
+ * @param [in] timedWordFileName filename of the timed word. When it is "stdin", the monitor reads from standard input.
+ * @param [in] useMmapReader read the timed word with MmapTimedWordParser if true
+ * @param [in] threads the number of the threads of the monitor
+ * @param [in] batchSize the number of the events parsed before they are passed to the monitor
+ * @param [in] usePipeline run the parser, the monitor, and the printer on separate threads if true and the monitor is
+ * thread-safe
+ * @param [in] budget the budget of the configurations of the monitor
+ * @param [in] guardMemo the options of the memos of the guards of the data-parametric and parametric monitors
+ * @param [in] outputFormat the format of the results
+ */
+template <typename TAType, typename Number, typename Timestamp, typename Monitor, typename Printer>
+int runMonitor(const TAType &TA, const Signature &signature, const std::string &timedWordFileName, bool useMmapReader,
+               std::size_t threads, std::size_t batchSize, bool usePipeline, const MonitorBudget &budget,
+               const GuardMemoOptions &guardMemo, OutputFormat outputFormat) {
+  // construct BooleanPrinter
+  const auto printer = std::make_shared<Printer>(outputFormat);
+
+  // construct Monitor
+  std::shared_ptr<Monitor> monitor;
+  try {
+    // The Boolean monitors have no memo of the guards.
+    if constexpr (std::is_constructible_v<Monitor, const TAType &, std::size_t, MonitorBudget, GuardMemoOptions>) {
+      monitor = std::make_shared<Monitor>(TA, threads, budget, guardMemo);
+    } else {
+      monitor = std::make_shared<Monitor>(TA, threads, budget);
+    }
+  } catch (const std::runtime_error &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+  monitor->addObserver(printer);
+
+  // construct TimedWordParser
+  std::unique_ptr<AbstractTimedWordParser<Number, Timestamp>> timedWordParser;
+  std::fstream timedWordFileStream;
+  if (useMmapReader) {
+    if (timedWordFileName == "stdin") {
+      timedWordParser = std::make_unique<MmapTimedWordParser<Number, Timestamp>>(STDIN_FILENO, signature);
+    } else {
+      try {
+        timedWordParser = std::make_unique<MmapTimedWordParser<Number, Timestamp>>(timedWordFileName, signature);
+      } catch (const std::runtime_error &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+      }
+    }
+  } else if (timedWordFileName == "stdin") {
+    timedWordParser = std::make_unique<TimedWordParser<Number, Timestamp>>(std::cin, signature);
+  } else {
+    timedWordFileStream.open(timedWordFileName);
+    if (timedWordFileStream.fail()) {
+      std::cerr << "Error: " << strerror(errno) << " " << timedWordFileName.c_str() << std::endl;
+      return 1;
+    }
+    timedWordParser = std::make_unique<TimedWordParser<Number, Timestamp>>(timedWordFileStream, signature);
+  }
+
+  try {
+    // The printers of the PPL monitors read the polyhedra of the results on their own thread.
+    if (usePipeline && Monitor::isThreadSafe) {
+      runPipeline(*timedWordParser, std::move(monitor), *printer, pipelineCapacity, batchSize,
+                  Monitor::makeThreadContext);
+    } else {
+      // construct TimedWordSubject
+      TimedWordSubject<Number, Timestamp> timedWordSubject(std::move(timedWordParser), batchSize);
+      timedWordSubject.addObserver(monitor);
+
+      // monitor all
+      timedWordSubject.parseAndSubjectAll();
+    }
+    // The destructor of the monitor notifies the last results and adds the counters of its guard memos.
+    monitor.reset();
+  } catch (const std::runtime_error &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    reportBudget(budget);
+    return 1;
+  }
+  reportBudget(budget);
+  reportGuardMemo(guardMemo);
+  return 0;
+}
+
 /*!
  * @brief Execute the monitoring procedure
  *
  * @param [in] timedAutomatonFileName filename of the timed automaton
  * @param [in] signatureFileName filename of the sugnature
  * @param [in] timedWordFileName filename of the timed word. When it is "stdin", the monitor reads from standard input.
+ * @param [in] useNewSyntax use the new syntax of the specification if true
+ * @param [in] useMmapReader read the timed word with MmapTimedWordParser if true
+ * @param [in] threads the number of the threads of the monitor
+ * @param [in] batchSize the number of the events parsed before they are passed to the monitor
+ * @param [in] usePipeline run the parser, the monitor, and the printer on separate threads if true
+ * @param [in] budget the budget of the configurations of the monitor
+ * @param [in] guardMemo the options of the memos of the guards of the data-parametric and parametric monitors
+ * @param [in] outputFormat the format of the results
+ * @tparam FallbackMonitor the monitor used instead of Monitor if Monitor does not support the automaton
  */
 template <typename TAType, typename BoostTAType, typename Number, typename Timestamp, typename Monitor,
           typename Printer, typename StringConstraint, typename NumberConstraint, typename TimingConstraintType,
-          typename UpdateType>
+          typename UpdateType, typename FallbackMonitor = Monitor>
 int execute(const std::string &timedAutomatonFileName, const std::string &signatureFileName,
-            const std::string &timedWordFileName, bool useNewSyntax = false) {
+            const std::string &timedWordFileName, bool useNewSyntax = false, bool useMmapReader = false,
+            std::size_t threads = 1,
+            std::size_t batchSize = TimedWordSubject<Number, Timestamp>::defaultBatchSize, bool usePipeline = false,
+            const MonitorBudget &budget = {}, const GuardMemoOptions &guardMemo = {},
+            OutputFormat outputFormat = OutputFormat::Text) {
   TAType TA;
   Signature signature;
 
@@ -77,34 +207,61 @@ int execute(const std::string &timedAutomatonFileName, const std::string &signat
     signature = Signature(signatureStream);
   }
 
-  // construct BooleanPrinter
-  const auto printer = std::make_shared<Printer>();
-
-  // construct Monitor
-  const auto monitor = std::make_shared<Monitor>(TA);
-  monitor->addObserver(printer);
-
-  // construct TimedWordParser
-  std::unique_ptr<TimedWordParser<Number, Timestamp>> timedWordParser;
-  std::fstream timedWordFileStream;
-  if (timedWordFileName == "stdin") {
-    timedWordParser = std::make_unique<TimedWordParser<Number, Timestamp>>(std::cin, signature);
-  } else {
-    timedWordFileStream.open(timedWordFileName);
-    if (timedWordFileStream.fail()) {
-      std::cerr << "Error: " << strerror(errno) << " " << timedWordFileName.c_str() << std::endl;
-      return 1;
+  if constexpr (!std::is_same_v<Monitor, FallbackMonitor>) {
+    if (!Monitor::supports(TA)) {
+      return runMonitor<TAType, Number, Timestamp, FallbackMonitor, Printer>(
+          TA, signature, timedWordFileName, useMmapReader, threads, batchSize, usePipeline, budget, guardMemo,
+          outputFormat);
     }
-    timedWordParser = std::make_unique<TimedWordParser<Number, Timestamp>>(timedWordFileStream, signature);
   }
+  return runMonitor<TAType, Number, Timestamp, Monitor, Printer>(TA, signature, timedWordFileName, useMmapReader,
+                                                                  threads, batchSize, usePipeline, budget, guardMemo,
+                                                                  outputFormat);
+}
 
-  // construct TimedWordSubject
-  TimedWordSubject<Number, Timestamp> timedWordSubject(std::move(timedWordParser));
-  timedWordSubject.addObserver(monitor);
-
-  // monitor all
-  timedWordSubject.parseAndSubjectAll();
-  return 0;
+/*!
+ * @brief Execute the data-parametric monitoring procedure with the given domains
+ *
+ * @param [in] numberDomainName the domain of the number variables: box, octagon, or polyhedron. If the box or the
+ * octagon does not represent the number guards and updates exactly, the polyhedra are used instead.
+ * @tparam ClockValuation the domain of the clocks
+ */
+template <typename ClockValuation>
+int executeDataParametric(const std::string &numberDomainName, const std::string &timedAutomatonFileName,
+                          const std::string &signatureFileName, const std::string &timedWordFileName,
+                          bool useNewSyntax, bool useMmapReader, std::size_t threads, std::size_t batchSize,
+                          bool usePipeline, const MonitorBudget &budget, const GuardMemoOptions &guardMemo,
+                          OutputFormat outputFormat) {
+  using PolyhedronMonitor = BasicDataParametricMonitor<ClockValuation>;
+  if (numberDomainName == "box") {
+    return execute<DataParametricTA, DataParametricBoostTA, PPLRational, double,
+                   BasicDataParametricMonitor<ClockValuation, Symbolic::BoxNumberValuation>, DataParametricPrinter,
+                   Symbolic::StringConstraint, Symbolic::NumberConstraint, std::vector<TimingConstraint>,
+                   Symbolic::Update, PolyhedronMonitor>(timedAutomatonFileName, signatureFileName, timedWordFileName,
+                                                        useNewSyntax, useMmapReader, threads, batchSize, usePipeline,
+                                                        budget, guardMemo, outputFormat);
+  } else if (numberDomainName == "octagon") {
+    return execute<DataParametricTA, DataParametricBoostTA, PPLRational, double,
+                   BasicDataParametricMonitor<ClockValuation, Symbolic::OctagonNumberValuation>,
+                   DataParametricPrinter, Symbolic::StringConstraint, Symbolic::NumberConstraint,
+                   std::vector<TimingConstraint>, Symbolic::Update, PolyhedronMonitor>(
+        timedAutomatonFileName, signatureFileName, timedWordFileName, useNewSyntax, useMmapReader, threads, batchSize,
+        usePipeline, budget, guardMemo, outputFormat);
+  }
+  if (threads <= 1) {
+    // The configurations share their polyhedra, which must be used by one thread.
+    return execute<DataParametricTA, DataParametricBoostTA, PPLRational, double,
+                   BasicDataParametricMonitor<ClockValuation, Symbolic::SharedNumberValuation>, DataParametricPrinter,
+                   Symbolic::StringConstraint, Symbolic::NumberConstraint, std::vector<TimingConstraint>,
+                   Symbolic::Update>(timedAutomatonFileName, signatureFileName, timedWordFileName, useNewSyntax,
+                                     useMmapReader, threads, batchSize, usePipeline, budget, guardMemo, outputFormat);
+  }
+  return execute<DataParametricTA, DataParametricBoostTA, PPLRational, double, PolyhedronMonitor,
+                 DataParametricPrinter, Symbolic::StringConstraint, Symbolic::NumberConstraint,
+                 std::vector<TimingConstraint>, Symbolic::Update>(timedAutomatonFileName, signatureFileName,
+                                                                  timedWordFileName, useNewSyntax, useMmapReader,
+                                                                  threads, batchSize, usePipeline, budget, guardMemo,
+                                                                  outputFormat);
 }
 
 int main(int argc, char *argv[]) {
@@ -132,12 +289,49 @@ int main(int argc, char *argv[]) {
   std::string signatureFileName;
   std::string timedWordFileName;
   std::string timedAutomatonFileName;
+  std::string readerName;
+  std::string timingDomainName;
+  std::string numberDomainName;
+  std::string budgetPolicyName;
+  std::string outputFormatName;
+  MonitorBudget budget;
+  GuardMemoOptions guardMemo;
+  std::size_t threads;
+  std::size_t batchSize;
   visible.add_options()("help,h", "help")("boolean,b", "non-parametric and  boolean mode")("dataparametric,d",
                                                                                            "data-parametric mode")(
       "parametric,p", "parametric mode")("new,n", "use the experimental syntax of SyMon")("version,V", "version")(
       "input,i", value<std::string>(&timedWordFileName)->default_value("stdin"), "input file of Timed Words")(
       "automaton,f", value<std::string>(&timedAutomatonFileName)->default_value(""), "input file of Timed Automaton")(
-      "signature,s", value<std::string>(&signatureFileName)->default_value(""), "input file of signature");
+      "signature,s", value<std::string>(&signatureFileName)->default_value(""), "input file of signature")(
+      "reader", value<std::string>(&readerName)->default_value("stream"),
+      "reader of Timed Words: stream (std::istream) or mmap (memory-mapped file or buffered read)")(
+      "threads", value<std::size_t>(&threads)->default_value(1),
+      "number of threads to expand the configurations")(
+      "batch-size", value<std::size_t>(&batchSize)->default_value(TimedWordSubject<Number>::defaultBatchSize),
+      "number of events passed to the monitor at once (1 for the lowest latency)")(
+      "no-pipeline",
+      "run the parser, the monitor, and the printer on one thread (always in the data-parametric and parametric modes "
+      "unless PPL is thread-safe)")(
+      "timing-domain", value<std::string>(&timingDomainName)->default_value("concrete"),
+      "domain of the clocks: concrete (clock values, or polyhedra in the parametric mode) or zone (zones, or "
+      "parametric DBMs in the parametric mode)")(
+      "number-domain", value<std::string>(&numberDomainName)->default_value("polyhedron"),
+      "domain of the number variables in the data-parametric mode: box, octagon, or polyhedron. The polyhedra are "
+      "used if the box or the octagon is not exact for the automaton")(
+      "max-configurations", value<std::size_t>(&budget.maxConfigurations)->default_value(0),
+      "maximum number of configurations after each event (0 for no limit)")(
+      "max-bytes", value<std::size_t>(&budget.maxBytes)->default_value(0),
+      "maximum approximate bytes of the configurations after each event (0 for no limit)")(
+      "budget-policy", value<std::string>(&budgetPolicyName)->default_value("abort"),
+      "what to do when the configurations exceed the budget: abort, drop (the oldest partial matches; Boolean and "
+      "data-parametric modes), or merge (the convex hull of the number valuations; data-parametric and parametric "
+      "modes)")(
+      "guard-memo-capacity", value<std::size_t>(&guardMemo.capacity)->default_value(guardMemo.capacity),
+      "maximum number of results of the guards memoized by each thread in the data-parametric and parametric modes "
+      "(0 for no memo). If given, the hits and misses are printed to the standard error")(
+      "output-format", value<std::string>(&outputFormatName)->default_value("text"),
+      "format of the results: text or binary (the records read by symon_convert)");
 
   command_line_parser parser(argc, argv);
   parser.options(visible);
@@ -160,43 +354,136 @@ int main(int argc, char *argv[]) {
     die("only one mode can be specified!!", 1);
   }
 
+  if (readerName != "stream" && readerName != "mmap") {
+    die("the reader must be either stream or mmap", 1);
+  }
+  const bool useMmapReader = readerName == "mmap";
+
+  if (threads == 0) {
+    die("the number of threads must be positive", 1);
+  }
+  if (batchSize == 0) {
+    die("the batch size must be positive", 1);
+  }
+  const bool usePipeline = !vm.count("no-pipeline");
+  if (timingDomainName != "concrete" && timingDomainName != "zone") {
+    die("the timing domain must be either concrete or zone", 1);
+  }
+  const bool useZone = timingDomainName == "zone";
+  if (numberDomainName != "box" && numberDomainName != "octagon" && numberDomainName != "polyhedron") {
+    die("the number domain must be either box, octagon, or polyhedron", 1);
+  }
+  if (numberDomainName != "polyhedron" && !vm.count("dataparametric")) {
+    die("the number domain is only available in the data-parametric mode", 1);
+  }
+  if (budgetPolicyName == "abort") {
+    budget.policy = BudgetPolicy::Abort;
+  } else if (budgetPolicyName == "drop") {
+    if (vm.count("parametric")) {
+      die("the drop policy is not available in the parametric mode", 1);
+    }
+    budget.policy = BudgetPolicy::Drop;
+  } else if (budgetPolicyName == "merge") {
+    if (!vm.count("dataparametric") && !vm.count("parametric")) {
+      die("the merge policy is only available in the data-parametric and parametric modes", 1);
+    }
+    budget.policy = BudgetPolicy::Merge;
+  } else {
+    die("the budget policy must be either abort, drop, or merge", 1);
+  }
+  budget.counters = std::make_shared<BudgetCounters>();
+  if (!vm["guard-memo-capacity"].defaulted()) {
+    if (!vm.count("dataparametric") && !vm.count("parametric")) {
+      die("the guard memo is only available in the data-parametric and parametric modes", 1);
+    }
+    guardMemo.counters = std::make_shared<GuardMemoCounters>();
+  }
+  if (outputFormatName != "text" && outputFormatName != "binary") {
+    die("the output format must be either text or binary", 1);
+  }
+  const OutputFormat outputFormat = outputFormatName == "binary" ? OutputFormat::Binary : OutputFormat::Text;
+
   if (vm.count("new")) {
     // Use the new syntax parser
     if (vm.count("parametric")) {
       // parametric with new syntax
+      if (useZone) {
+        return execute<ParametricTA, BoostPTA, PPLRational, PPLRational, BasicParametricMonitor<ParametricDBMDomain>,
+                       ParametricPrinter, Symbolic::StringConstraint, Symbolic::NumberConstraint,
+                       ParametricTimingConstraint, Symbolic::Update, ParametricMonitor>(
+            timedAutomatonFileName, signatureFileName, timedWordFileName, true, useMmapReader, threads, batchSize,
+            usePipeline, budget, guardMemo, outputFormat);
+      }
       return execute<ParametricTA, BoostPTA, PPLRational, PPLRational, ParametricMonitor, ParametricPrinter,
                      Symbolic::StringConstraint, Symbolic::NumberConstraint, ParametricTimingConstraint,
-                     Symbolic::Update>(timedAutomatonFileName, signatureFileName, timedWordFileName, true);
+                     Symbolic::Update>(timedAutomatonFileName, signatureFileName, timedWordFileName, true,
+                                       useMmapReader, threads, batchSize, usePipeline, budget, guardMemo, outputFormat);
     } else if (vm.count("dataparametric")) {
       // data parametric with new syntax
-      return execute<DataParametricTA, DataParametricBoostTA, PPLRational, double, DataParametricMonitor,
-                     DataParametricPrinter, Symbolic::StringConstraint, Symbolic::NumberConstraint,
-                     std::vector<TimingConstraint>, Symbolic::Update>(timedAutomatonFileName, signatureFileName,
-                                                                      timedWordFileName, true);
+      if (useZone) {
+        return executeDataParametric<Zone>(numberDomainName, timedAutomatonFileName, signatureFileName,
+                                           timedWordFileName, true, useMmapReader, threads, batchSize, usePipeline,
+                                           budget, guardMemo, outputFormat);
+      }
+      return executeDataParametric<TimingValuation>(numberDomainName, timedAutomatonFileName, signatureFileName,
+                                                    timedWordFileName, true, useMmapReader, threads, batchSize,
+                                                    usePipeline, budget, guardMemo, outputFormat);
     } else {
       // boolean with new syntax
+      if (useZone) {
+        return execute<NonParametricTA<Number>, NonParametricBoostTA<Number>, Number, double,
+                       BooleanMonitor<Number, Zone>, BooleanPrinter<Number>, NonSymbolic::StringConstraint,
+                       NonSymbolic::NumberConstraint<Number>, std::vector<TimingConstraint>,
+                       NonSymbolic::Update<Number>>(timedAutomatonFileName, signatureFileName, timedWordFileName,
+                                                    true, useMmapReader, threads, batchSize, usePipeline, budget,
+                                                    guardMemo, outputFormat);
+      }
       return execute<NonParametricTA<Number>, NonParametricBoostTA<Number>, Number, double, BooleanMonitor<Number>,
                      BooleanPrinter<Number>, NonSymbolic::StringConstraint, NonSymbolic::NumberConstraint<Number>,
                      std::vector<TimingConstraint>, NonSymbolic::Update<Number>>(timedAutomatonFileName, signatureFileName,
-                                                                         timedWordFileName, true);
+                                                                         timedWordFileName, true, useMmapReader,
+                                                                         threads, batchSize, usePipeline, budget,
+                                                                         guardMemo, outputFormat);
     }
   } else if (vm.count("parametric")) {
     // parametric
+    if (useZone) {
+      return execute<ParametricTA, BoostPTA, PPLRational, PPLRational, BasicParametricMonitor<ParametricDBMDomain>,
+                     ParametricPrinter, Symbolic::StringConstraint, Symbolic::NumberConstraint,
+                     ParametricTimingConstraint, Symbolic::Update, ParametricMonitor>(
+          timedAutomatonFileName, signatureFileName, timedWordFileName, false, useMmapReader, threads, batchSize,
+          usePipeline, budget, guardMemo, outputFormat);
+    }
     return execute<ParametricTA, BoostPTA, PPLRational, PPLRational, ParametricMonitor, ParametricPrinter,
                    Symbolic::StringConstraint, Symbolic::NumberConstraint, ParametricTimingConstraint,
-                   Symbolic::Update>(timedAutomatonFileName, signatureFileName, timedWordFileName, false);
+                   Symbolic::Update>(timedAutomatonFileName, signatureFileName, timedWordFileName, false,
+                                     useMmapReader, threads, batchSize, usePipeline, budget, guardMemo, outputFormat);
   } else if (vm.count("dataparametric")) {
     // data parametric
-    return execute<DataParametricTA, DataParametricBoostTA, PPLRational, double, DataParametricMonitor,
-                   DataParametricPrinter, Symbolic::StringConstraint, Symbolic::NumberConstraint,
-                   std::vector<TimingConstraint>, Symbolic::Update>(timedAutomatonFileName, signatureFileName,
-                                                                    timedWordFileName, false);
+    if (useZone) {
+      return executeDataParametric<Zone>(numberDomainName, timedAutomatonFileName, signatureFileName,
+                                         timedWordFileName, false, useMmapReader, threads, batchSize, usePipeline,
+                                         budget, guardMemo, outputFormat);
+    }
+    return executeDataParametric<TimingValuation>(numberDomainName, timedAutomatonFileName, signatureFileName,
+                                                  timedWordFileName, false, useMmapReader, threads, batchSize,
+                                                  usePipeline, budget, guardMemo, outputFormat);
   } else {
     // boolean
+    if (useZone) {
+      return execute<NonParametricTA<Number>, NonParametricBoostTA<Number>, Number, double,
+                     BooleanMonitor<Number, Zone>, BooleanPrinter<Number>, NonSymbolic::StringConstraint,
+                     NonSymbolic::NumberConstraint<Number>, std::vector<TimingConstraint>,
+                     NonSymbolic::Update<Number>>(timedAutomatonFileName, signatureFileName, timedWordFileName,
+                                                  false, useMmapReader, threads, batchSize, usePipeline, budget,
+                                                  guardMemo, outputFormat);
+    }
     return execute<NonParametricTA<Number>, NonParametricBoostTA<Number>, Number, double, BooleanMonitor<Number>,
                    BooleanPrinter<Number>, NonSymbolic::StringConstraint, NonSymbolic::NumberConstraint<Number>,
                    std::vector<TimingConstraint>, NonSymbolic::Update<Number>>(timedAutomatonFileName, signatureFileName,
-                                                                       timedWordFileName, false);
+                                                                       timedWordFileName, false, useMmapReader,
+                                                                       threads, batchSize, usePipeline, budget,
+                                                                       guardMemo, outputFormat);
   }
   return 0;
 }
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "signature.hh"
+#include "timed_word_parser.hh"
+
+/*!
+  @brief Parse a number from the entire token.
+
+  @note This overload handles the arithmetic types. The other number types (e.g., PPLRational) provide their own
+  overload, which is found by ADL.
+  @retval true If the entire token represents a number
+ */
+template <typename Number>
+std::enable_if_t<std::is_arithmetic_v<Number>, bool> fromChars(std::string_view token, Number &value) {
+  // std::from_chars does not accept the leading '+' while operator>> does.
+  if (!token.empty() && token.front() == '+') {
+    token.remove_prefix(1);
+  }
+  const char *last = token.data() + token.size();
+  const auto [ptr, ec] = std::from_chars(token.data(), last, value);
+  return ec == std::errc() && ptr == last;
+}
+
+/*!
+  @brief Parser of a timed word without any per-token heap allocation.
+
+  If the input is a regular file, the entire file is memory-mapped. Otherwise (e.g., stdin or a pipe), the input is
+  read through a large buffer. In both cases, the tokens are std::string_views of the mapped memory or the buffer, and
+  the strings in the event are interned directly from them.
+
+  @note The accepted format is the same as TimedWordParser.
+ */
+template <typename Number, typename TimeStamp = double>
+class MmapTimedWordParser : public AbstractTimedWordParser<Number, TimeStamp> {
+public:
+  static constexpr std::size_t defaultBufferSize = 1 << 20;
+
+  /*!
+    @brief Read the timed word in the given file.
+
+    @throws std::runtime_error If the file cannot be opened.
+   */
+  MmapTimedWordParser(const std::string &fileName, const Signature &sig) : sig(sig) {
+    fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error(std::string(strerror(errno)) + " " + fileName);
+    }
+    ownsFd = true;
+    struct stat st {};
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+      if (st.st_size == 0) {
+        // mmap does not accept an empty mapping
+        eof = true;
+        return;
+      }
+      void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        mapped = static_cast<const char *>(addr);
+        mappedSize = st.st_size;
+        madvise(addr, mappedSize, MADV_SEQUENTIAL);
+        pos = mapped;
+        end = mapped + mappedSize;
+        eof = true;
+        return;
+      }
+    }
+    // Fall back to the buffered read, e.g., for named pipes
+    buffer.resize(defaultBufferSize);
+    pos = end = buffer.data();
+  }
+
+  /*!
+    @brief Read the timed word from the given file descriptor (e.g., STDIN_FILENO) through a buffer.
+
+    @note The file descriptor is not closed by this parser.
+   */
+  MmapTimedWordParser(int fd, const Signature &sig, std::size_t bufferSize = defaultBufferSize)
+      : sig(sig), fd(fd), buffer(std::max<std::size_t>(bufferSize, 1)) {
+    pos = end = buffer.data();
+  }
+
+  MmapTimedWordParser(const MmapTimedWordParser &) = delete;
+  MmapTimedWordParser &operator=(const MmapTimedWordParser &) = delete;
+
+  ~MmapTimedWordParser() override {
+    if (mapped) {
+      munmap(const_cast<char *>(mapped), mappedSize);
+    }
+    if (ownsFd) {
+      close(fd);
+    }
+  }
+
+  /*!
+    @brief Parse and return an event with data
+    @retval true If the parse succeeded
+    @retval false If the parse failed
+   */
+  bool parse(TimedWordEvent<Number, TimeStamp> &event) override {
+    std::string_view token;
+    while (true) {
+      if (!nextToken(token)) {
+        return false;
+      }
+      const Signature::Entry *entry = sig.find(token);
+      if (!entry) {
+        std::cerr << "Undefined action: " << token << std::endl;
+        skipLine();
+        continue;
+      }
+      const std::size_t stringSize = entry->stringSize;
+      const std::size_t numberSize = entry->numberSize;
+      event.actionId = entry->id;
+      event.strings.resize(stringSize);
+      for (std::size_t i = 0; i < stringSize; i++) {
+        if (!nextToken(token)) {
+          return false;
+        }
+        event.strings[i] = InternedString(token);
+      }
+      event.numbers.resize(numberSize);
+      bool valid = true;
+      for (std::size_t i = 0; i < numberSize && valid; i++) {
+        if (!nextToken(token)) {
+          return false;
+        }
+        valid = fromChars(token, event.numbers[i]);
+      }
+      if (valid) {
+        if (!nextToken(token)) {
+          return false;
+        }
+        valid = fromChars(token, event.timestamp);
+      }
+      if (!valid) {
+        std::cerr << "Invalid number: " << token << std::endl;
+        skipLine();
+        continue;
+      }
+      return true;
+    }
+  }
+
+private:
+  const Signature &sig;
+  int fd = -1;
+  bool ownsFd = false;
+  //! @brief The memory-mapped file. It is nullptr if we use the buffered read.
+  const char *mapped = nullptr;
+  std::size_t mappedSize = 0;
+  std::vector<char> buffer;
+  //! @brief The unread part of the input is [pos, end).
+  const char *pos = nullptr;
+  const char *end = nullptr;
+  //! @brief If true, there is no more input after end.
+  bool eof = false;
+
+  static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  /*!
+    @brief Move the unread part to the head of the buffer and read more data.
+    @retval false If we reached EOF
+   */
+  bool refill() {
+    if (eof) {
+      return false;
+    }
+    const std::size_t rest = end - pos;
+    if (rest == buffer.size()) {
+      // A token is longer than the buffer.
+      const std::size_t offset = pos - buffer.data();
+      buffer.resize(buffer.size() * 2);
+      pos = buffer.data() + offset;
+      end = pos + rest;
+    }
+    std::memmove(buffer.data(), pos, rest);
+    pos = buffer.data();
+    end = pos + rest;
+    while (true) {
+      const ssize_t readSize = read(fd, buffer.data() + rest, buffer.size() - rest);
+      if (readSize < 0 && errno == EINTR) {
+        continue;
+      }
+      if (readSize <= 0) {
+        eof = true;
+        return rest > 0;
+      }
+      end += readSize;
+      return true;
+    }
+  }
+
+  /*!
+    @brief Find the next whitespace-separated token.
+
+    @note The token is valid until the next call of nextToken or skipLine.
+   */
+  bool nextToken(std::string_view &token) {
+    while (true) {
+      while (pos < end && isSpace(*pos)) {
+        ++pos;
+      }
+      if (pos == end) {
+        if (!refill()) {
+          return false;
+        }
+        continue;
+      }
+      const char *tokenEnd = pos;
+      while (tokenEnd < end && !isSpace(*tokenEnd)) {
+        ++tokenEnd;
+      }
+      if (tokenEnd == end && !eof) {
+        // The token may continue in the data not read yet.
+        refill();
+        continue;
+      }
+      token = std::string_view(pos, tokenEnd - pos);
+      pos = tokenEnd;
+      return true;
+    }
+  }
+
+  //! @brief Skip the input until the next line feed.
+  void skipLine() {
+    while (true) {
+      const void *lineFeed = std::memchr(pos, '\n', end - pos);
+      if (lineFeed) {
+        pos = static_cast<const char *>(lineFeed) + 1;
+        return;
+      }
+      pos = end;
+      if (!refill()) {
+        return;
+      }
+    }
+  }
+};
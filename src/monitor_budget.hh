@@ -0,0 +1,172 @@
+#pragma once
+
+#include <boost/container/small_vector.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*!
+  @brief What a monitor does when its configurations exceed the budget
+ */
+enum class BudgetPolicy {
+  //! @brief Stop monitoring with a diagnostic
+  Abort,
+  //! @brief Drop the oldest partial matches, i.e., the configurations that left an initial state the earliest
+  Drop,
+  //! @brief Over-approximate the configurations differing only in the symbolic number valuation by their convex hull
+  Merge,
+};
+
+//! @brief The counters of the interventions of the budget
+struct BudgetCounters {
+  //! @brief The number of the events after which the budget was exceeded
+  std::size_t exceeded = 0;
+  //! @brief The number of the configurations dropped by BudgetPolicy::Drop
+  std::size_t dropped = 0;
+  //! @brief The number of the configurations merged into another by BudgetPolicy::Merge
+  std::size_t merged = 0;
+  //! @brief The largest number of the configurations after an event, before the budget is applied
+  std::size_t peakConfigurations = 0;
+};
+
+/*!
+  @brief The budget of the configurations of a monitor
+
+  The budget is checked after each event. The memory of a configuration is approximated by its size and the heap
+  memory of its valuations.
+ */
+struct MonitorBudget {
+  //! @brief The maximum number of the configurations, or zero for no limit
+  std::size_t maxConfigurations = 0;
+  //! @brief The maximum approximate bytes of the configurations, or zero for no limit
+  std::size_t maxBytes = 0;
+  BudgetPolicy policy = BudgetPolicy::Abort;
+  //! @brief If given, the monitor updates the counters. They are shared so that they outlive the monitor.
+  std::shared_ptr<BudgetCounters> counters;
+
+  //! @brief The start of the configurations at an initial state, which are never dropped
+  static constexpr std::size_t initialStart = std::numeric_limits<std::size_t>::max();
+
+  [[nodiscard]] bool limits() const {
+    return maxConfigurations > 0 || maxBytes > 0;
+  }
+
+  [[nodiscard]] bool limitsBytes() const {
+    return maxBytes > 0;
+  }
+
+  //! @brief Returns if the configurations are within the budget. The bytes are ignored unless limitsBytes().
+  [[nodiscard]] bool allows(std::size_t configurations, std::size_t bytes) const {
+    return (maxConfigurations == 0 || configurations <= maxConfigurations) && (maxBytes == 0 || bytes <= maxBytes);
+  }
+
+  //! @brief Record the number of the configurations after an event.
+  void record(std::size_t configurations) const {
+    if (counters) {
+      counters->peakConfigurations = std::max(counters->peakConfigurations, configurations);
+    }
+  }
+
+  /*!
+    @brief Record that the budget is exceeded, and throws if the policy is BudgetPolicy::Abort.
+    @param events The number of the events processed so far
+   */
+  void exceed(std::size_t events, std::size_t configurations, std::size_t bytes) const {
+    if (counters) {
+      counters->exceeded++;
+    }
+    if (policy == BudgetPolicy::Abort) {
+      fail(events, configurations, bytes);
+    }
+  }
+
+  //! @throws std::runtime_error Always, with the diagnostic of the exceeded budget
+  [[noreturn]] static void fail(std::size_t events, std::size_t configurations, std::size_t bytes) {
+    std::string message = "the configuration budget is exceeded after " + std::to_string(events) + " events: " +
+                          std::to_string(configurations) + " configurations";
+    if (bytes > 0) {
+      message += " (about " + std::to_string(bytes) + " bytes)";
+    }
+    throw std::runtime_error(message);
+  }
+
+  /*!
+    @brief Returns the approximate bytes of each configuration if limitsBytes(), or an empty vector otherwise.
+    @tparam Configurations A range of the configurations with approximateBytes()
+   */
+  template <typename Configurations>
+  [[nodiscard]] std::vector<std::size_t> measure(const Configurations &configurations) const {
+    std::vector<std::size_t> bytes;
+    if (limitsBytes()) {
+      for (const auto &conf: configurations) {
+        bytes.push_back(conf.approximateBytes());
+      }
+    }
+    return bytes;
+  }
+
+  static std::size_t total(const std::vector<std::size_t> &bytes) {
+    return std::accumulate(bytes.begin(), bytes.end(), std::size_t{0});
+  }
+
+  /*!
+    @brief Drop the oldest configurations until the others are within the budget.
+
+    @param events The number of the events processed so far
+    @param configurations The configurations in a ConfigurationFrontier
+    @param bytes The result of measure(configurations)
+    @param start A function returning the index of the event at which the configuration left an initial state, or
+    initialStart if it is at an initial state. Such configurations are never dropped.
+    @throws std::runtime_error If the configurations at the initial states alone exceed the budget
+   */
+  template <typename Frontier, typename Start>
+  void dropOldest(std::size_t events, Frontier &configurations, const std::vector<std::size_t> &bytes,
+                  Start start) const {
+    std::vector<std::size_t> starts;
+    starts.reserve(configurations.size());
+    for (const auto &conf: configurations) {
+      starts.push_back(start(conf));
+    }
+    std::vector<std::size_t> order(starts.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&starts](std::size_t i, std::size_t j) { return starts[i] < starts[j]; });
+    std::size_t size = starts.size();
+    std::size_t totalBytes = total(bytes);
+    std::vector<bool> removed(starts.size(), false);
+    for (const std::size_t i: order) {
+      if (allows(size, totalBytes) || starts[i] == initialStart) {
+        break;
+      }
+      removed[i] = true;
+      --size;
+      totalBytes -= bytes.empty() ? 0 : bytes[i];
+    }
+    const std::size_t droppedSize = configurations.remove(removed);
+    if (counters) {
+      counters->dropped += droppedSize;
+    }
+    if (!allows(size, totalBytes)) {
+      fail(events, size, limitsBytes() ? totalBytes : 0);
+    }
+  }
+};
+
+/*!
+  @name The approximate heap memory of the valuations
+ */
+//! @{
+template <typename T, std::size_t N>
+std::size_t externalMemoryInBytes(const boost::container::small_vector<T, N> &vec) {
+  return vec.capacity() > N ? vec.capacity() * sizeof(T) : 0;
+}
+
+template <typename T> std::size_t externalMemoryInBytes(const std::vector<T> &vec) {
+  return vec.capacity() * sizeof(T);
+}
+//! @}
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <boost/container/small_vector.hpp>
 #include <cassert>
 #include <memory>
 #include <optional>
@@ -13,9 +14,9 @@
 namespace NonSymbolic {
   /*!
     @brief valuation of number variables
-    @note We do nothing symbolic.
+    @note We do nothing symbolic. The valuation is stored inline if it has at most four variables.
   */
-  template <typename Number> using NumberValuation = std::vector<std::optional<Number>>;
+  template <typename Number> using NumberValuation = boost::container::small_vector<std::optional<Number>, 4>;
 
   enum class NumberExpressionKind { ATOM, PLUS, MINUS, CONSTANT };
   
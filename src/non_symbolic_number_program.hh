@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "non_symbolic_number_constraint.hh"
+
+namespace NonSymbolic {
+  enum class NumberOpcode : std::uint8_t {
+    //! @brief Push the value of the variable of the operand.
+    LOAD,
+    //! @brief Push the constant of the operand.
+    CONSTANT,
+    //! @brief Pop the right and the left operands, and push their sum.
+    PLUS,
+    //! @brief Pop the right and the left operands, and push their difference.
+    MINUS,
+    //! @brief Pop the right and the left operands, and stop with false if the comparison does not hold.
+    GT,
+    GE,
+    EQ,
+    NE,
+    LE,
+    LT,
+    //! @brief Pop the value and assign it to the variable of the operand.
+    STORE
+  };
+
+  struct NumberInstruction {
+    NumberOpcode opcode;
+    //! @brief The variable for LOAD and STORE, the index of the constant for CONSTANT, and unused otherwise
+    std::uint32_t operand = 0;
+  };
+
+  /*!
+    @brief The number guard and the number update of a transition compiled to a flat stack-machine bytecode
+
+    The instructions of the guard and the update are stored in one contiguous vector, and they are evaluated by a loop
+    without recursion. The stack is stored inline unless an expression is deeper than inlineStackSize.
+
+    @note The result of PLUS and MINUS is undefined (std::nullopt) if an operand is undefined, and a comparison with an
+    undefined operand does not hold.
+    @note More operators can be added as opcodes without changing the layout.
+   */
+  template <typename Number> class NumberProgram {
+  public:
+    static constexpr std::size_t inlineStackSize = 8;
+
+    NumberProgram() = default;
+
+    /*!
+      @param constraints The conjunction of the number constraints of the guard
+      @param updates The number updates, which are assigned in order
+     */
+    NumberProgram(const std::vector<NumberConstraint<Number>> &constraints,
+                  const std::vector<std::pair<VariableID, NumberExpression<Number>>> &updates) {
+      std::size_t depth = 0;
+      for (const auto &constraint: constraints) {
+        compile(constraint.children[0], depth);
+        compile(constraint.children[1], depth);
+        code.push_back({comparator(constraint.kind)});
+        depth -= 2;
+      }
+      updateBegin = code.size();
+      for (const auto &[to, from]: updates) {
+        compile(from, depth);
+        code.push_back({NumberOpcode::STORE, static_cast<std::uint32_t>(to)});
+        depth--;
+      }
+    }
+
+    //! @brief Returns if the number guard holds.
+    bool guard(const NumberValuation<Number> &env) const {
+      return run(0, updateBegin, env);
+    }
+
+    //! @brief Apply the number updates.
+    void update(NumberValuation<Number> &env) const {
+      run(updateBegin, code.size(), env);
+    }
+
+  private:
+    std::vector<NumberInstruction> code;
+    std::vector<Number> constants;
+    //! @brief The guard is code[0, updateBegin) and the update is code[updateBegin, code.size()).
+    std::size_t updateBegin = 0;
+    //! @brief The maximum depth of the stack
+    std::size_t maxDepth = 0;
+
+    static NumberOpcode comparator(NumberComparatorKind kind) {
+      switch (kind) {
+        case NumberComparatorKind::GT:
+          return NumberOpcode::GT;
+        case NumberComparatorKind::GE:
+          return NumberOpcode::GE;
+        case NumberComparatorKind::EQ:
+          return NumberOpcode::EQ;
+        case NumberComparatorKind::NE:
+          return NumberOpcode::NE;
+        case NumberComparatorKind::LE:
+          return NumberOpcode::LE;
+        case NumberComparatorKind::LT:
+          return NumberOpcode::LT;
+      }
+      return NumberOpcode::EQ;
+    }
+
+    //! @brief Append the postfix code of the expression. The depth is the depth of the stack before and after it.
+    void compile(const NumberExpression<Number> &expr, std::size_t &depth) {
+      switch (expr.kind) {
+        case NumberExpressionKind::ATOM:
+          code.push_back({NumberOpcode::LOAD, static_cast<std::uint32_t>(std::get<VariableID>(expr.child))});
+          maxDepth = std::max(maxDepth, ++depth);
+          return;
+        case NumberExpressionKind::CONSTANT:
+          code.push_back({NumberOpcode::CONSTANT, static_cast<std::uint32_t>(constants.size())});
+          constants.push_back(std::get<Number>(expr.child));
+          maxDepth = std::max(maxDepth, ++depth);
+          return;
+        case NumberExpressionKind::PLUS:
+        case NumberExpressionKind::MINUS: {
+          const auto &children = std::get<1>(expr.child);
+          compile(*children[0], depth);
+          compile(*children[1], depth);
+          code.push_back({expr.kind == NumberExpressionKind::PLUS ? NumberOpcode::PLUS : NumberOpcode::MINUS});
+          depth--;
+          return;
+        }
+      }
+    }
+
+    template <typename Env> bool run(std::size_t begin, std::size_t end, Env &env) const {
+      boost::container::small_vector<std::optional<Number>, inlineStackSize> stack(maxDepth);
+      auto top = stack.begin();
+      for (std::size_t pc = begin; pc < end; ++pc) {
+        const NumberInstruction &instruction = code[pc];
+        switch (instruction.opcode) {
+          case NumberOpcode::LOAD:
+            *top++ = env[instruction.operand];
+            break;
+          case NumberOpcode::CONSTANT:
+            *top++ = constants[instruction.operand];
+            break;
+          case NumberOpcode::PLUS:
+          case NumberOpcode::MINUS: {
+            --top;
+            auto &left = *(top - 1);
+            if (left && *top) {
+              left = instruction.opcode == NumberOpcode::PLUS ? *left + **top : *left - **top;
+            } else {
+              left = std::nullopt;
+            }
+            break;
+          }
+          case NumberOpcode::STORE:
+            if constexpr (!std::is_const_v<Env>) {
+              env[instruction.operand] = *--top;
+            }
+            break;
+          default: {
+            top -= 2;
+            if (!top[0] || !top[1] || !compare(instruction.opcode, *top[0], *top[1])) {
+              return false;
+            }
+          }
+        }
+      }
+      return true;
+    }
+
+    static bool compare(NumberOpcode opcode, const Number &left, const Number &right) {
+      switch (opcode) {
+        case NumberOpcode::GT:
+          return left > right;
+        case NumberOpcode::GE:
+          return left >= right;
+        case NumberOpcode::EQ:
+          return left == right;
+        case NumberOpcode::NE:
+          return left != right;
+        case NumberOpcode::LE:
+          return left <= right;
+        case NumberOpcode::LT:
+          return left < right;
+        default:
+          return false;
+      }
+    }
+  };
+} // namespace NonSymbolic
@@ -1,22 +1,28 @@
 #pragma once
 
 #include <array>
+#include <boost/container/small_vector.hpp>
 #include <optional>
 #include <string>
 #include <variant>
 #include <vector>
 
 #include "common_types.hh"
+#include "string_pool.hh"
 
 namespace NonSymbolic {
-  using StringValuation = std::vector<std::optional<std::string>>;
+  /*!
+    @brief valuation of string variables
+    @note The valuation is stored inline if it has at most four variables.
+  */
+  using StringValuation = boost::container::small_vector<std::optional<InternedString>, 4>;
 
   struct StringAtom {
-    std::variant<VariableID, std::string> value;
+    std::variant<VariableID, InternedString> value;
 
-    void eval(const StringValuation &env, std::variant<VariableID, std::string> &result) const {
-      if (std::holds_alternative<std::string>(value)) {
-        result = std::get<std::string>(value);
+    void eval(const StringValuation &env, std::variant<VariableID, InternedString> &result) const {
+      if (std::holds_alternative<InternedString>(value)) {
+        result = std::get<InternedString>(value);
       } else if (env.at(std::get<std::size_t>(value))) {
         result = *env.at(std::get<std::size_t>(value));
       } else {
@@ -39,7 +45,7 @@ namespace NonSymbolic {
     enum class kind_t { EQ, NE } kind;
 
     bool eval(StringValuation &env) const {
-      std::array<std::variant<VariableID, std::string>, 2> evaluated;
+      std::array<std::variant<VariableID, InternedString>, 2> evaluated;
       for (int i = 0; i < 2; i++) {
         children[i].eval(env, evaluated[i]);
       }
@@ -49,19 +55,19 @@ namespace NonSymbolic {
               std::holds_alternative<VariableID>(evaluated[1])) {
             throw "Unimplemented case: At least one of the children must have a concrete value. "
                   "StringConstraint";
-          } else if (std::holds_alternative<std::string>(evaluated[0]) &&
+          } else if (std::holds_alternative<InternedString>(evaluated[0]) &&
                      std::holds_alternative<VariableID>(evaluated[1])) {
             const auto assignedID = std::get<VariableID>(evaluated[1]);
-            const auto &assignedString = std::get<std::string>(evaluated[0]);
+            const auto assignedString = std::get<InternedString>(evaluated[0]);
             return assignIfPossible(env, assignedID, assignedString);
           } else if (std::holds_alternative<VariableID>(evaluated[0]) &&
-                     std::holds_alternative<std::string>(evaluated[1])) {
+                     std::holds_alternative<InternedString>(evaluated[1])) {
             const auto assignedID = std::get<VariableID>(evaluated[0]);
-            const auto &assignedString = std::get<std::string>(evaluated[1]);
+            const auto assignedString = std::get<InternedString>(evaluated[1]);
             return assignIfPossible(env, assignedID, assignedString);
           } else {
-            const auto &evaluated0 = std::get<std::string>(evaluated[0]);
-            const auto &evaluated1 = std::get<std::string>(evaluated[1]);
+            const auto evaluated0 = std::get<InternedString>(evaluated[0]);
+            const auto evaluated1 = std::get<InternedString>(evaluated[1]);
             return evaluated0 == evaluated1;
           }
         }
@@ -70,15 +76,15 @@ namespace NonSymbolic {
               std::holds_alternative<VariableID>(evaluated[1])) {
             throw "Unimplemented case: At least one of the children must have a concrete value. "
                   "StringConstraint";
-          } else if (std::holds_alternative<std::string>(evaluated[0]) &&
+          } else if (std::holds_alternative<InternedString>(evaluated[0]) &&
                      std::holds_alternative<VariableID>(evaluated[1])) {
             return true;
           } else if (std::holds_alternative<VariableID>(evaluated[0]) &&
-                     std::holds_alternative<std::string>(evaluated[1])) {
+                     std::holds_alternative<InternedString>(evaluated[1])) {
             return true;
           } else {
-            const auto &evaluated0 = std::get<std::string>(evaluated[0]);
-            const auto &evaluated1 = std::get<std::string>(evaluated[1]);
+            const auto evaluated0 = std::get<InternedString>(evaluated[0]);
+            const auto evaluated1 = std::get<InternedString>(evaluated[1]);
             return evaluated0 != evaluated1;
           }
         }
@@ -87,7 +93,7 @@ namespace NonSymbolic {
     }
 
   private:
-    bool assignIfPossible(StringValuation &env, const VariableID assignedID, const std::string &assignedString) const {
+    bool assignIfPossible(StringValuation &env, const VariableID assignedID, const InternedString assignedString) const {
       if (!env[assignedID]) {
         // assignedString is not disabled
         env[assignedID] = assignedString;
@@ -104,7 +110,7 @@ namespace NonSymbolic {
     explicit SCMaker(VariableID id) : first({id}) {
     }
 
-    StringConstraint operator==(const std::string &str) const {
+    StringConstraint operator==(const InternedString str) const {
       const StringAtom second{str};
       return {{first, second}, StringConstraint::kind_t::EQ};
     }
@@ -114,7 +120,7 @@ namespace NonSymbolic {
       return {{first, second}, StringConstraint::kind_t::EQ};
     }
 
-    StringConstraint operator!=(const std::string &str) const {
+    StringConstraint operator!=(const InternedString str) const {
       const StringAtom second{str};
       return {{first, second}, StringConstraint::kind_t::NE};
     }
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "non_symbolic_number_constraint.hh"
+#include "non_symbolic_number_program.hh"
 #include "non_symbolic_string_constraint.hh"
 
 namespace NonSymbolic {
@@ -23,31 +24,40 @@ namespace NonSymbolic {
                        [&numEnv](const NumberConstraint<Number> &constraint) { return constraint.eval(numEnv); });
   }
 
+  template <typename Number>
+  bool eval(const std::vector<StringConstraint> &stringConstraints, StringValuation &stringEnv,
+            const NumberProgram<Number> &numProgram, const NumberValuation<Number> &numEnv) {
+    return std::all_of(stringConstraints.begin(), stringConstraints.end(),
+                       [&stringEnv](const StringConstraint &constraint) { return constraint.eval(stringEnv); }) &&
+           numProgram.guard(numEnv);
+  }
+
   template <typename Number>
   struct Update {
     std::vector<std::pair<VariableID, NonSymbolic::StringAtom>> stringUpdate;
     std::vector<std::pair<VariableID, NonSymbolic::NumberExpression<Number>>> numberUpdate;
 
     void execute(StringValuation &stringEnv, NumberValuation<Number> &numEnv) const {
-      for (const auto &update: stringUpdate) {
-        const auto from = update.second;
-        const auto to = update.first;
-        std::variant<VariableID, std::string> result;
-        from.eval(stringEnv, result);
-        std::optional<std::string> opt = std::nullopt;
-        if (std::holds_alternative<std::string>(result)) {
-          opt = std::get<std::string>(result);
-        }
-        stringEnv[to] = opt;
-      }
-      for (const auto &update: numberUpdate) {
-        const auto from = update.second;
-        const auto to = update.first;
+      executeString(stringEnv);
+      for (const auto &[to, from]: numberUpdate) {
         std::optional<Number> result;
         from.eval(numEnv, result);
         numEnv[to] = result;
       }
     }
+
+    //! @brief Apply only the string updates. The number updates are applied by the compiled NumberProgram.
+    void executeString(StringValuation &stringEnv) const {
+      for (const auto &[to, from]: stringUpdate) {
+        std::variant<VariableID, InternedString> result;
+        from.eval(stringEnv, result);
+        std::optional<InternedString> opt = std::nullopt;
+        if (std::holds_alternative<InternedString>(result)) {
+          opt = std::get<InternedString>(result);
+        }
+        stringEnv[to] = opt;
+      }
+    }
   };
 } // namespace NonSymbolic
 #endif // DATAMONITOR_NON_SYMBOLIC_UPDATE_HH
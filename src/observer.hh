@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 /*!
   @brief Abstract Class for observer pattrn
   @sa Subject
@@ -7,4 +9,16 @@
 template <typename T> class Observer {
 public:
   virtual void notify(const T &) = 0;
+
+  /*!
+    @brief Receive the given size of data at once in order.
+
+    By default, this calls notify for each of them. An observer may override it to amortize the virtual dispatch and
+    the setup per data.
+   */
+  virtual void notifyBatch(const T *data, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      notify(data[i]);
+    }
+  }
 };
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+/*!
+  @brief A reusable buffer of the output of the printers, which is passed to the sink in large blocks
+
+  The integers and the floating-point numbers are formatted by std::to_chars directly into the buffer, and the output
+  is the same as std::ostream with the default precision. The other values, e.g., the polyhedra, are printed by their
+  operator<< through stream(), which writes into the same buffer. Nothing is allocated after the construction.
+
+  The buffer is passed to the sink when it is full, and by drain() and flush(), which are the explicit flush points.
+  It is flushed when it is destroyed.
+ */
+class OutputBuffer : private std::streambuf {
+public:
+  static constexpr std::size_t defaultCapacity = 1 << 16;
+
+  //! @param capacity The size of the buffer. It is at least 1024 bytes so that any number fits in it.
+  explicit OutputBuffer(std::ostream &sink = std::cout, std::size_t capacity = defaultCapacity)
+      : sink(sink), buffer(std::max<std::size_t>(capacity, 1024)), outputStream(this) {
+    setp(buffer.data(), buffer.data() + buffer.size());
+  }
+
+  OutputBuffer(const OutputBuffer &) = delete;
+  OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+  ~OutputBuffer() override {
+    flush();
+  }
+
+  //! @brief Pass the buffered output to the sink without flushing the sink.
+  void drain() {
+    sink.write(pbase(), pptr() - pbase());
+    setp(buffer.data(), buffer.data() + buffer.size());
+  }
+
+  //! @brief Pass the buffered output to the sink and flush it.
+  void flush() {
+    drain();
+    sink.flush();
+  }
+
+  OutputBuffer &write(std::string_view str) {
+    if (static_cast<std::size_t>(epptr() - pptr()) < str.size()) {
+      drain();
+      if (buffer.size() < str.size()) {
+        sink.write(str.data(), str.size());
+        return *this;
+      }
+    }
+    std::memcpy(pptr(), str.data(), str.size());
+    pbump(static_cast<int>(str.size()));
+    return *this;
+  }
+
+  OutputBuffer &put(char ch) {
+    if (pptr() == epptr()) {
+      drain();
+    }
+    *pptr() = ch;
+    pbump(1);
+    return *this;
+  }
+
+  template <typename Integer> OutputBuffer &writeInteger(Integer value) {
+    static_assert(std::is_integral_v<Integer>);
+    return format(value);
+  }
+
+  //! @brief Write the number as std::fixed, i.e., with six digits after the decimal point.
+  OutputBuffer &writeFixed(double value) {
+    return format(value, std::chars_format::fixed, 6);
+  }
+
+  //! @brief Write the number as std::defaultfloat, i.e., with six significant digits for a floating-point number.
+  template <typename Number> OutputBuffer &writeNumber(Number value) {
+    if constexpr (std::is_integral_v<Number>) {
+      return writeInteger(value);
+    } else if constexpr (std::is_floating_point_v<Number>) {
+      return format(value, std::chars_format::general, 6);
+    } else {
+      outputStream << value;
+      return *this;
+    }
+  }
+
+  //! @brief The stream writing into this buffer, for the values printed by their operator<<
+  std::ostream &stream() {
+    return outputStream;
+  }
+
+private:
+  std::ostream &sink;
+  std::vector<char> buffer;
+  std::ostream outputStream;
+
+  template <typename Value, typename... Options> OutputBuffer &format(Value value, Options... options) {
+    auto result = std::to_chars(pptr(), epptr(), value, options...);
+    if (result.ec != std::errc()) {
+      drain();
+      result = std::to_chars(pptr(), epptr(), value, options...);
+    }
+    pbump(static_cast<int>(result.ptr - pptr()));
+    return *this;
+  }
+
+  int_type overflow(int_type ch) override {
+    drain();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize xsputn(const char *str, std::streamsize size) override {
+    write(std::string_view(str, size));
+    return size;
+  }
+
+  int sync() override {
+    drain();
+    return 0;
+  }
+};
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <boost/functional/hash.hpp>
+#include <cassert>
+#include <optional>
+#include <vector>
+
+#include "parametric_timing_constraint.hh"
+#include "ppl_rational.hh"
+
+/*!
+  @brief A set of parameter and clock valuations represented by a parametric difference bound matrix (DBM)
+
+  The variables are x_0, which is the constant zero, the parameters x_1, ..., x_{|P|}, and the clocks. The variable
+  x_{i + 1} is the dimension i of ParametricTimingValuation. The entry (i, j) is the bound of x_i - x_j. Unlike the
+  clocks of Zone, the parameters do not elapse.
+
+  This represents exactly the conjunctions of the constraints of the form x - p ~ c, x ~ c, and p ~ c (and the
+  differences of two clocks or two parameters), which are all the guards of, e.g., the periodic-window specifications.
+  The matrix is always kept canonical, so two non-empty sets are equal if and only if their matrices are equal.
+ */
+class ParametricDBM {
+public:
+  //! @brief A bound (value, strict) meaning "< value" if strict and "<= value" otherwise
+  struct Bound {
+    PPLRational value;
+    bool strict;
+    bool infinite = false;
+
+    static Bound infinity() {
+      return {0, true, true};
+    }
+    bool operator<(const Bound &other) const {
+      if (infinite || other.infinite) {
+        return !infinite && other.infinite;
+      }
+      return value < other.value || (value == other.value && strict && !other.strict);
+    }
+    bool operator==(const Bound &other) const {
+      return infinite == other.infinite && (infinite || (value == other.value && strict == other.strict));
+    }
+    Bound operator+(const Bound &other) const {
+      if (infinite || other.infinite) {
+        return infinity();
+      }
+      return {value + other.value, strict || other.strict};
+    }
+  };
+
+  //! @brief The constraint x_i - x_j < bound (if strict) or x_i - x_j <= bound
+  struct Difference {
+    std::size_t i, j;
+    Bound bound;
+  };
+
+  //! @brief A guard is a conjunction of the differences.
+  using Guard = std::vector<Difference>;
+
+  ParametricDBM() : ParametricDBM(0, 0) {
+  }
+
+  //! @brief The set where all the parameters are non-negative and all the clocks are zero
+  ParametricDBM(std::size_t parameterSize, std::size_t clockSize)
+      : parameterSize(parameterSize), size(parameterSize + 1), dbm(size * size, Bound::infinity()) {
+    for (std::size_t i = 0; i < size; ++i) {
+      bound(i, i) = {0, false};
+      // 0 - p <= 0
+      bound(0, i) = {0, false};
+    }
+    for (std::size_t x = 0; x < clockSize; ++x) {
+      addClock();
+    }
+  }
+
+  //! @brief Returns the number of the parameters and the clocks, i.e., the dimension of the ParametricTimingValuation.
+  [[nodiscard]] std::size_t dimension() const {
+    return size - 1;
+  }
+
+  //! @brief Returns the bound of x_i - x_j.
+  [[nodiscard]] const Bound &at(std::size_t i, std::size_t j) const {
+    return dbm[i * size + j];
+  }
+
+  //! @brief Add a clock after the current ones, whose value is zero.
+  void addClock() {
+    std::vector<Bound> extended((size + 1) * (size + 1));
+    for (std::size_t i = 0; i < size; ++i) {
+      std::copy(dbm.begin() + i * size, dbm.begin() + (i + 1) * size, extended.begin() + i * (size + 1));
+    }
+    dbm = std::move(extended);
+    ++size;
+    reset(size - 2 - parameterSize);
+  }
+
+  //! @brief Remove the last clock. Since the matrix is canonical, this is the projection.
+  void removeClock() {
+    assert(size > parameterSize + 1);
+    for (std::size_t i = 1; i + 1 < size; ++i) {
+      std::copy(dbm.begin() + i * size, dbm.begin() + i * size + size - 1, dbm.begin() + i * (size - 1));
+    }
+    --size;
+    dbm.resize(size * size);
+  }
+
+  //! @brief Let the given duration elapse. This shifts the clocks and keeps the matrix canonical.
+  void elapse(const PPLRational &duration) {
+    for (std::size_t i = parameterSize + 1; i < size; ++i) {
+      for (std::size_t j = 0; j <= parameterSize; ++j) {
+        if (!bound(i, j).infinite) {
+          bound(i, j).value = bound(i, j).value + duration;
+        }
+        if (!bound(j, i).infinite) {
+          bound(j, i).value = bound(j, i).value - duration;
+        }
+      }
+    }
+  }
+
+  //! @brief Let an arbitrary duration elapse. This removes the upper bounds of the clocks and keeps it canonical.
+  void elapse() {
+    for (std::size_t i = parameterSize + 1; i < size; ++i) {
+      for (std::size_t j = 0; j <= parameterSize; ++j) {
+        bound(i, j) = Bound::infinity();
+      }
+    }
+  }
+
+  //! @brief Reset the clock to zero. This keeps the matrix canonical.
+  void reset(std::size_t x) {
+    const std::size_t i = parameterSize + 1 + x;
+    for (std::size_t j = 0; j < size; ++j) {
+      bound(i, j) = bound(0, j);
+      bound(j, i) = bound(j, 0);
+    }
+    bound(i, i) = {0, false};
+  }
+
+  //! @brief Intersect the set with the guard, and returns false if the result is empty.
+  bool constrain(const Guard &guard) {
+    for (const Difference &difference: guard) {
+      if (!constrain(difference)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //! @brief Intersect the set with x_i - x_j ~ c, and returns false if the result is empty.
+  bool constrain(const Difference &difference) {
+    const auto &[i, j, b] = difference;
+    assert(i < size && j < size);
+    if (!(b < bound(i, j))) {
+      return true;
+    }
+    if (b + bound(j, i) < Bound{0, false}) {
+      return false;
+    }
+    // Since the other entries are canonical, the paths via the new edge are enough to make the matrix canonical.
+    bound(i, j) = b;
+    for (std::size_t k = 0; k < size; ++k) {
+      if (bound(k, i).infinite) {
+        continue;
+      }
+      for (std::size_t l = 0; l < size; ++l) {
+        tighten(k, l, bound(k, i) + b + bound(j, l));
+      }
+    }
+    return true;
+  }
+
+  /*!
+    @brief Compile a guard to the differences.
+
+    @returns The differences, or std::nullopt if the guard has a constraint that is not a bound of one variable or of
+    the difference of two variables.
+   */
+  static std::optional<Guard> compile(const ParametricTimingConstraint &guard) {
+    using Parma_Polyhedra_Library::Coefficient;
+    Guard result;
+    for (const auto &constraint: guard.minimized_constraints()) {
+      // The constraint is a * x_positive - a * x_negative + b >= 0 (or > 0 or == 0) with a > 0.
+      std::size_t positive = 0, negative = 0;
+      Coefficient a = 0;
+      for (std::size_t d = 0; d < constraint.space_dimension(); ++d) {
+        const Coefficient c = constraint.coefficient(Parma_Polyhedra_Library::Variable(d));
+        if (c == 0) {
+          continue;
+        }
+        if (c > 0 && positive == 0 && (a == 0 || a == c)) {
+          positive = d + 1;
+          a = c;
+        } else if (c < 0 && negative == 0 && (a == 0 || a == -c)) {
+          negative = d + 1;
+          a = -c;
+        } else {
+          return std::nullopt;
+        }
+      }
+      const Coefficient b = constraint.inhomogeneous_term();
+      if (a == 0) {
+        if (b < 0 || (b == 0 && constraint.is_strict_inequality())) {
+          // x_0 - x_0 <= -1 makes the set empty
+          result.push_back({0, 0, {-1, false}});
+        }
+        continue;
+      }
+      // x_negative - x_positive <= b / a
+      const PPLRational value(b, a);
+      result.push_back({negative, positive, {value, constraint.is_strict_inequality()}});
+      if (constraint.is_equality()) {
+        result.push_back({positive, negative, {-value, false}});
+      }
+    }
+    return result;
+  }
+
+  //! @brief Returns the polyhedron of the same set.
+  [[nodiscard]] ParametricTimingValuation toPolyhedron() const {
+    ParametricTimingValuation result(dimension());
+    for (std::size_t i = 0; i < size; ++i) {
+      for (std::size_t j = 0; j < size; ++j) {
+        const Bound &b = at(i, j);
+        if (i == j || b.infinite) {
+          continue;
+        }
+        // x_i - x_j <= n / d, i.e., d * x_i - d * x_j <= n
+        Parma_Polyhedra_Library::Linear_Expression expr;
+        if (i > 0) {
+          expr += Parma_Polyhedra_Library::Variable(i - 1);
+        }
+        if (j > 0) {
+          expr -= Parma_Polyhedra_Library::Variable(j - 1);
+        }
+        expr *= b.value.getDenominator();
+        if (b.strict) {
+          result.add_constraint(expr < b.value.getNumerator());
+        } else {
+          result.add_constraint(expr <= b.value.getNumerator());
+        }
+      }
+    }
+    return result;
+  }
+
+  //! @brief Returns if this set contains the other set.
+  [[nodiscard]] bool contains(const ParametricDBM &other) const {
+    if (size != other.size) {
+      return false;
+    }
+    for (std::size_t k = 0; k < dbm.size(); ++k) {
+      if (dbm[k] < other.dbm[k]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator==(const ParametricDBM &other) const {
+    return size == other.size && dbm == other.dbm;
+  }
+  bool operator!=(const ParametricDBM &other) const {
+    return !(*this == other);
+  }
+
+  friend std::size_t hash_value(const ParametricDBM &pdbm) {
+    std::size_t seed = pdbm.size;
+    for (const Bound &b: pdbm.dbm) {
+      boost::hash_combine(seed, b.infinite);
+      if (!b.infinite) {
+        boost::hash_combine(seed, b.value);
+        boost::hash_combine(seed, b.strict);
+      }
+    }
+    return seed;
+  }
+
+  //! @brief Returns the approximate heap memory of the matrix.
+  friend std::size_t externalMemoryInBytes(const ParametricDBM &pdbm) {
+    return pdbm.dbm.capacity() * sizeof(Bound);
+  }
+
+private:
+  std::size_t parameterSize;
+  std::size_t size;
+  std::vector<Bound> dbm;
+
+  Bound &bound(std::size_t i, std::size_t j) {
+    return dbm[i * size + j];
+  }
+
+  //! @brief Replace the bound of x_i - x_j if the given one is tighter.
+  void tighten(std::size_t i, std::size_t j, const Bound &b) {
+    if (b < bound(i, j)) {
+      bound(i, j) = b;
+    }
+  }
+};
@@ -1,16 +1,23 @@
 #pragma once
 
 #include "automaton.hh"
+#include "compiled_automaton.hh"
+#include "monitor_budget.hh"
 #include "observer.hh"
 #include "parametric_timing_constraint.hh"
+#include "parametric_timing_domain.hh"
 #include "ppl_rational.hh"
+#include "ppl_thread_safety.hh"
 #include "subject.hh"
 #include "symbolic_number_constraint.hh"
 #include "symbolic_string_constraint.hh"
 #include "symbolic_update.hh"
 #include "timed_word_subject.hh"
 
+#include "thread_pool.hh"
+
 #include <boost/unordered_set.hpp>
+#include <optional>
 
 struct ParametricMonitorResult {
   std::size_t index;
@@ -25,254 +32,412 @@ struct ParametricMonitorResult {
  * transitions.
  * @note The label of the unobservable events is 127 (This will be modified in a future version).
  * @note If the last trantision is an unobservable transition, the timestamp is that of the latest event.
+ * @note With multiple threads, each of the time elapse, the unobservable transitions, the observable transitions, and
+ * the merge of the number valuations is run in parallel over the configurations with work stealing. The successors
+ * are merged in the order of the configurations, and the matches are notified in the same order as the
+ * single-threaded monitor.
+ * @tparam TimingDomain The representation of the parameter and clock valuations, i.e., ParametricPolyhedronDomain or
+ * ParametricDBMDomain
  */
-class ParametricMonitor : public SingleSubject<ParametricMonitorResult>,
-                          public Observer<TimedWordEvent<PPLRational, PPLRational>> {
+template <typename TimingDomain = ParametricPolyhedronDomain>
+class BasicParametricMonitor : public SingleSubject<ParametricMonitorResult>,
+                               public Observer<TimedWordEvent<PPLRational, PPLRational>> {
 public:
   static const constexpr std::size_t unobservableActinoID = 127;
+  //! @brief If the monitor can use more than one thread and run apart from the printer, which needs PPL built with
+  //! thread safety.
+  static constexpr bool isThreadSafe = pplThreadSafe;
+
+  /*!
+    @param threads The number of the threads to expand the configurations.
+    @param budget The budget of the configurations. The policy must be BudgetPolicy::Abort or BudgetPolicy::Merge.
+    @param guardMemo The options of the memos of the guards of the threads
 
-  explicit ParametricMonitor(const ParametricTA &automaton) : automaton(automaton) {
+    @note Each worker thread has its own Parma_Polyhedra_Library::Thread_Init and its own copy of the polyhedra in the
+    automaton and the timing domain, and no PPL object is accessed by more than one thread at a time. This requires PPL
+    built with thread safety, which is checked by CMake (pplThreadSafe).
+    @throws std::runtime_error If the timing domain does not support a guard, if the policy of the budget is
+    BudgetPolicy::Drop, which needs the configurations ordered by their age, or if there are more than one threads and
+    PPL is not built with thread safety
+   */
+  explicit BasicParametricMonitor(const ParametricTA &automaton, std::size_t threads = 1, MonitorBudget budget = {},
+                                  GuardMemoOptions guardMemo = {})
+      : automaton(automaton), compiled(automaton), timingDomain(automaton, compiled, guardMemo.capacity),
+        budget(std::move(budget)), guardMemo(std::move(guardMemo)) {
+    if (this->budget.policy == BudgetPolicy::Drop) {
+      throw std::runtime_error("ParametricMonitor: the drop policy of the budget is not supported");
+    }
+    if (threads > 1 && !isThreadSafe) {
+      throw std::runtime_error(
+          "ParametricMonitor: more than one thread needs PPL built with thread safety (--enable-thread-safe)");
+    }
     absTime = 0;
     configurations.clear();
     // 1 -- |P|: Parameters, |P| + 1 -- |P| + |C|: Clocks
-    ParametricTimingValuation initCVal(automaton.parameterSize);
-    initCVal.add_space_dimensions_and_project(automaton.clockVariableSize);
-    for (std::size_t i = 0; i < automaton.parameterSize; i++) {
-      initCVal.add_constraint(Parma_Polyhedra_Library::Variable(i) >= 0);
-    }
+    const ClockValuation initCVal = timingDomain.initial();
     // by default, initSEnv is no violating set (variant)
     Symbolic::StringValuation initSEnv(automaton.stringVariableSize);
     // by default, initNEnv is the universe of dimension automaton.numberVariableSize
     Symbolic::NumberValuation initNEnv(automaton.numberVariableSize);
-    for (const auto &initialState: automaton.initialStates) {
+    for (const auto initialState: compiled.initialStates()) {
       configurations.insert({initialState, initCVal, initSEnv, initNEnv});
     }
-    elapsePolyhedron =
-        Parma_Polyhedra_Library::NNC_Polyhedron(automaton.parameterSize + automaton.clockVariableSize + 1);
-    for (std::size_t i = 0; i < automaton.parameterSize; i++) {
-      elapsePolyhedron.add_constraint(Parma_Polyhedra_Library::Variable(i) == 0);
+    if (threads > 1) {
+      pool = std::make_unique<ThreadPool>(threads, makeThreadContext);
+      // Copying the compiled automaton and the timing domain copies the guards.
+      workerAutomata.assign(threads - 1, WorkerAutomaton{compiled, timingDomain});
     }
-    for (std::size_t i = automaton.parameterSize; i <= automaton.parameterSize + automaton.clockVariableSize; i++) {
-      elapsePolyhedron.add_constraint(Parma_Polyhedra_Library::Variable(i) == 1);
+  }
+
+  //! @brief Returns if the timing domain supports all the guards of the automaton.
+  static bool supports(const ParametricTA &automaton) {
+    return TimingDomain::supports(CompiledAutomaton<PTAState>(automaton), unobservableActinoID);
+  }
+
+  //! @brief Initialize PPL in a thread other than the main thread using this monitor, e.g., a worker thread.
+  static std::shared_ptr<void> makeThreadContext() {
+    return std::make_shared<Parma_Polyhedra_Library::Thread_Init>();
+  }
+
+  //! @brief Returns the numbers of the guards whose results are memoized and computed, summed over the threads.
+  [[nodiscard]] GuardMemoCounters guardMemoCounters() const {
+    GuardMemoCounters counters = timingDomain.guardMemoCounters();
+    for (const WorkerAutomaton &worker: workerAutomata) {
+      counters += worker.timingDomain.guardMemoCounters();
     }
+    return counters;
   }
 
   /*
    * @note it tries unobservable transitions after the last event.
    */
-  virtual ~ParametricMonitor() {
-    boost::unordered_set<Configuration> nextConfigurations;
-
-    boost::unordered_set<Configuration> currentConfigurations;
-    for (Configuration conf: configurations) {
-      // add a new dimension for time elapse.
-      std::get<1>(conf).add_space_dimensions_and_project(1);
-      currentConfigurations.insert(std::move(conf));
-    }
-    // Try unobservable transitions
-    while (!currentConfigurations.empty()) {
-      nextConfigurations.clear();
-      for (const Configuration &conf: currentConfigurations) {
-        auto transitionIt = std::get<0>(conf)->next.find(unobservableActinoID);
-        if (transitionIt == std::get<0>(conf)->next.end()) {
-          continue;
-        }
-        // make the current env
-        auto clockValuation = std::get<1>(conf);
-        assert(clockValuation.space_dimension() == automaton.parameterSize + automaton.clockVariableSize + 1);
-        clockValuation.time_elapse_assign(elapsePolyhedron);
-        const auto stringEnv = std::get<2>(conf);
-        const auto numberEnv = std::get<3>(conf);
-        for (const auto &transition: transitionIt->second) {
-          // evaluate the guards
-          auto nextCVal = clockValuation;
-          auto nextSEnv = stringEnv;
-          auto nextNEnv = numberEnv;
-          auto extendedGuard = transition.guard;
-          extendedGuard.add_space_dimensions_and_embed(1);
-          if (eval(nextCVal, extendedGuard) &&
-              eval(transition.stringConstraints, nextSEnv, transition.numConstraints, nextNEnv)) {
-            for (const VariableID resetVar: transition.resetVars) {
-              nextCVal.affine_image(Parma_Polyhedra_Library::Variable(automaton.parameterSize + resetVar),
-                                    Parma_Polyhedra_Library::Linear_Expression(0));
-            }
-            transition.update.execute(nextSEnv, nextNEnv);
-            nextConfigurations.insert({transition.target.lock(), nextCVal, nextSEnv, nextNEnv});
-            nextCVal.remove_higher_space_dimensions(automaton.parameterSize + automaton.clockVariableSize);
-            if (transition.target.lock()->isMatch) {
-              notifyObservers({index, absTime, nextNEnv, nextSEnv, nextCVal});
-            }
-          }
-        }
+  virtual ~BasicParametricMonitor() {
+    if (hasUnobservable) {
+      boost::unordered_set<Configuration> currentConfigurations;
+      for (Configuration conf: configurations) {
+        // add a new dimension for time elapse.
+        timingDomain.extend(std::get<1>(conf));
+        currentConfigurations.insert(std::move(conf));
       }
-
-      std::swap(currentConfigurations, nextConfigurations);
+      unobservableTransitions(std::move(currentConfigurations), std::nullopt);
+    }
+    if (guardMemo.counters) {
+      *guardMemo.counters += guardMemoCounters();
     }
   }
 
   void notify(const TimedWordEvent<PPLRational, PPLRational> &event) override {
-    const Action actionId = event.actionId;
-    const std::vector<std::string> &strings = event.strings;
-    const std::vector<PPLRational> &numbers = event.numbers;
     const PPLRational timestamp = event.timestamp;
     const auto dwellTime = timestamp - absTime;
-    boost::unordered_set<Configuration> nextConfigurations;
 
-    boost::unordered_set<Configuration> currentConfigurations;
-    for (Configuration conf: configurations) {
-      // add a new dimension for time elapse.
-      std::get<1>(conf).add_space_dimensions_and_project(1);
-      currentConfigurations.insert(std::move(conf));
-    }
     // time elapse to the timestamp of the current event
-    for (Configuration conf: configurations) {
-      for (std::size_t i = 0; i < automaton.clockVariableSize; i++) {
-        //! @todo Currently, the timestamp is mpz (integer). I will make it mpq (quadratic) later.
-        std::get<1>(conf).affine_image(Parma_Polyhedra_Library::Variable(automaton.parameterSize + i),
-                                       Parma_Polyhedra_Library::Variable(automaton.parameterSize + i) *
-                                               dwellTime.getDenominator() +
-                                           dwellTime.getNumerator(),
-                                       dwellTime.getDenominator());
+    std::vector<Configuration> elapsed(configurations.begin(), configurations.end());
+    std::vector<Configuration> extended(hasUnobservable ? elapsed.size() : 0);
+    forEach(elapsed.size(), [&](std::size_t i, std::size_t slot) {
+      if (hasUnobservable) {
+        extended[i] = elapsed[i];
+        // add a new dimension for time elapse.
+        localTimingDomain(slot).extend(std::get<1>(extended[i]));
       }
-      nextConfigurations.insert(std::move(conf));
-    }
-    std::swap(configurations, nextConfigurations);
+      localTimingDomain(slot).elapse(std::get<1>(elapsed[i]), dwellTime);
+    });
+    configurations = boost::unordered_set<Configuration>(std::make_move_iterator(elapsed.begin()),
+                                                         std::make_move_iterator(elapsed.end()));
 
     // Try unobservable transitions
-    while (!currentConfigurations.empty()) {
-      nextConfigurations.clear();
-      for (const Configuration &conf: currentConfigurations) {
-        auto transitionIt = std::get<0>(conf)->next.find(unobservableActinoID);
-        if (transitionIt == std::get<0>(conf)->next.end()) {
-          continue;
-        }
-        // make the current env
-        auto clockValuation = std::get<1>(conf);
-        clockValuation.time_elapse_assign(elapsePolyhedron);
-        clockValuation.add_constraint(
-            Parma_Polyhedra_Library::Variable(automaton.parameterSize + automaton.clockVariableSize) *
-                dwellTime.getDenominator() <=
-            dwellTime.getNumerator());
-        const auto stringEnv = std::get<2>(conf);
-        const auto numberEnv = std::get<3>(conf);
-        for (const auto &transition: transitionIt->second) {
-          // evaluate the guards
-          auto nextCVal = clockValuation;
-          auto nextSEnv = stringEnv;
-          auto nextNEnv = numberEnv;
-          auto extendedGuard = transition.guard;
-          extendedGuard.add_space_dimensions_and_embed(1);
-          if (eval(nextCVal, extendedGuard) &&
-              eval(transition.stringConstraints, nextSEnv, transition.numConstraints, nextNEnv)) {
-            for (const VariableID resetVar: transition.resetVars) {
-              nextCVal.affine_image(Parma_Polyhedra_Library::Variable(automaton.parameterSize + resetVar),
-                                    Parma_Polyhedra_Library::Linear_Expression(0));
-            }
-            transition.update.execute(nextSEnv, nextNEnv);
-            nextConfigurations.insert({transition.target.lock(), nextCVal, nextSEnv, nextNEnv});
-            if (transition.target.lock()->isMatch) {
-              auto tmpNCV = nextCVal;
-              tmpNCV.remove_higher_space_dimensions(automaton.parameterSize + automaton.clockVariableSize);
-              notifyObservers({index, absTime, nextNEnv, nextSEnv, tmpNCV});
-            }
-            // time elapse
-            for (std::size_t i = 0; i < automaton.clockVariableSize; i++) {
-              //! @todo Currently, the timestamp is mpz (integer). I will make it mpq (quadratic) later.
-              nextCVal.affine_image(
-                  Parma_Polyhedra_Library::Variable(automaton.parameterSize + i),
-                  Parma_Polyhedra_Library::Variable(automaton.parameterSize + i) * dwellTime.getDenominator() +
-                      dwellTime.getNumerator() -
-                      Parma_Polyhedra_Library::Variable(automaton.parameterSize + automaton.clockVariableSize) *
-                          dwellTime.getDenominator(),
-                  dwellTime.getDenominator());
-            }
-            nextCVal.remove_higher_space_dimensions(automaton.parameterSize + automaton.clockVariableSize);
-            configurations.insert({transition.target.lock(), nextCVal, nextSEnv, nextNEnv});
-          }
-        }
-      }
-
-      std::swap(currentConfigurations, nextConfigurations);
+    if (hasUnobservable) {
+      unobservableTransitions(boost::unordered_set<Configuration>(std::make_move_iterator(extended.begin()),
+                                                                  std::make_move_iterator(extended.end())),
+                              dwellTime);
     }
 
-    nextConfigurations.clear();
-    boost::unordered_map<std::tuple<std::shared_ptr<PTAState>, ParametricTimingValuation, Symbolic::StringValuation>,
-                         Parma_Polyhedra_Library::Pointset_Powerset<Symbolic::NumberValuation>>
-        mergedConfigurations;
-
     // Try observable transitions
-    for (const Configuration &conf: configurations) {
-      auto transitionIt = std::get<0>(conf)->next.find(actionId);
-      if (transitionIt == std::get<0>(conf)->next.end()) {
-        continue;
-      }
-      // make the current env
-      // The time elapsed in the above
-      auto clockValuation = std::get<1>(conf); //.clockValuation;
-      auto stringEnv = std::get<2>(conf);      //.stringEnv;
-      stringEnv.insert(stringEnv.end(), strings.begin(), strings.end());
-      auto numberEnv = std::get<3>(conf); //.numberEnv;
-      // add dimension for the data in the timed word.
-      assert(numberEnv.space_dimension() == automaton.numberVariableSize);
-      numberEnv.add_space_dimensions_and_embed(numbers.size());
-      for (std::size_t i = 0; i < numbers.size(); i++) {
-        numberEnv.add_constraint(Parma_Polyhedra_Library::Variable(automaton.numberVariableSize + i) *
-                                     numbers[i].getDenominator() ==
-                                 numbers[i].getNumerator());
-      }
-      for (const auto &transition: transitionIt->second) {
-        // evaluate the guards
-        auto nextCVal = clockValuation;
-        auto nextSEnv = stringEnv;
-        auto nextNEnv = numberEnv;
-        if (eval(nextCVal, transition.guard) &&
-            eval(transition.stringConstraints, nextSEnv, transition.numConstraints, nextNEnv)) {
-          for (const VariableID resetVar: transition.resetVars) {
-            nextCVal.affine_image(Parma_Polyhedra_Library::Variable(automaton.parameterSize + resetVar),
-                                  Parma_Polyhedra_Library::Linear_Expression(0));
-          }
-          transition.update.execute(nextSEnv, nextNEnv);
-          nextSEnv.resize(automaton.stringVariableSize);
-          nextNEnv.remove_higher_space_dimensions(automaton.numberVariableSize);
-          const auto key = std::make_tuple(transition.target.lock(), nextCVal, nextSEnv);
-          const auto it = mergedConfigurations.find(key);
-          if (it == mergedConfigurations.end()) {
-            mergedConfigurations[key] = Parma_Polyhedra_Library::Pointset_Powerset<Symbolic::NumberValuation>{nextNEnv};
-          } else {
-            it->second.add_disjunct(nextNEnv);
-          }
-          if (transition.target.lock()->isMatch) {
-            notifyObservers({index, timestamp, nextNEnv, nextSEnv, nextCVal});
-          }
+    std::vector<Configuration> sources(configurations.begin(), configurations.end());
+    std::vector<std::vector<ObservableSuccessor>> successors(sources.size());
+    forEach(sources.size(),
+            [&](std::size_t i, std::size_t slot) { observableSuccessors(sources[i], event, successors[i], slot); });
+    boost::unordered_map<MergedConfiguration, Parma_Polyhedra_Library::Pointset_Powerset<Symbolic::NumberValuation>>
+        mergedConfigurations;
+    for (auto &confSuccessors: successors) {
+      for (ObservableSuccessor &successor: confSuccessors) {
+        const auto it = mergedConfigurations.find(successor.configuration);
+        if (it == mergedConfigurations.end()) {
+          mergedConfigurations[successor.configuration] =
+              Parma_Polyhedra_Library::Pointset_Powerset<Symbolic::NumberValuation>{successor.numberEnv};
+        } else {
+          it->second.add_disjunct(successor.numberEnv);
+        }
+        if (successor.isMatch) {
+          notifyObservers({index, timestamp, successor.numberEnv, std::get<2>(successor.configuration),
+                           timingDomain.toPolyhedron(std::get<1>(successor.configuration))});
         }
       }
     }
     absTime = timestamp;
     index++;
     // merge numberEnv
+    std::vector<Parma_Polyhedra_Library::Pointset_Powerset<Symbolic::NumberValuation> *> numberEnvs;
+    numberEnvs.reserve(mergedConfigurations.size());
+    for (auto &conf: mergedConfigurations) {
+      numberEnvs.push_back(&conf.second);
+    }
+    forEach(numberEnvs.size(), [&](std::size_t i, std::size_t) { numberEnvs[i]->pairwise_reduce(); });
     configurations.clear();
     for (auto &conf: mergedConfigurations) {
-      conf.second.pairwise_reduce();
       for (auto numberEnv: conf.second) {
         configurations.insert(std::make_tuple(std::get<0>(conf.first), std::get<1>(conf.first), std::get<2>(conf.first),
                                               numberEnv.pointset()));
       }
     }
+    enforceBudget();
+  }
+
+  //! @brief Process the events in order without the virtual dispatch per event.
+  void notifyBatch(const TimedWordEvent<PPLRational, PPLRational> *events, std::size_t size) override {
+    for (std::size_t i = 0; i < size; ++i) {
+      BasicParametricMonitor::notify(events[i]);
+    }
   }
 
 private:
   const ParametricTA automaton;
-  using Configuration = std::tuple<std::shared_ptr<PTAState>, ParametricTimingValuation, Symbolic::StringValuation,
-                                   Symbolic::NumberValuation>;
-  // Symbolic::NumberValuation>;
-  /*  struct Configuration {
-      std::shared_ptr<DataParametricTAState> state;
-      std::vector<double> clockValuation;
-      NonSymbolic::StringValuation stringEnv;
-      Symbolic::NumberValuation numberEnv;
-    };*/
+  const CompiledAutomaton<PTAState> compiled;
+  const TimingDomain timingDomain;
+  //! @brief We skip the configurations extended for the time elapse if there are no unobservable transitions.
+  const bool hasUnobservable = compiled.hasAction(unobservableActinoID);
+  const MonitorBudget budget;
+  const GuardMemoOptions guardMemo;
+  using StateIndex = CompiledAutomaton<PTAState>::StateIndex;
+  using ClockValuation = typename TimingDomain::Valuation;
+  //! @note The state is the index in the compiled automaton.
+  using Configuration = std::tuple<StateIndex, ClockValuation, Symbolic::StringValuation, Symbolic::NumberValuation>;
+  //! @brief The successors of the observable transitions are merged if they differ only in the number valuation.
+  using MergedConfiguration = std::tuple<StateIndex, ClockValuation, Symbolic::StringValuation>;
+
+  //! @brief A successor by an unobservable transition
+  struct UnobservableSuccessor {
+    //! @brief The successor with the dimension for the time elapse
+    Configuration configuration;
+    std::optional<ParametricMonitorResult> match;
+    //! @brief The successor after the time elapse to the current event
+    std::optional<Configuration> elapsed;
+  };
+
+  //! @brief A successor by an observable transition
+  struct ObservableSuccessor {
+    MergedConfiguration configuration;
+    Symbolic::NumberValuation numberEnv;
+    bool isMatch;
+  };
+
+  /*!
+    @brief The copy of the compiled automaton used by a worker thread
+
+    PPL may update the internal representation of a polyhedron even in a const operation, e.g., the intersection with
+    a guard. Therefore, each worker thread uses its own copy of the guards and the timing domain.
+   */
+  struct WorkerAutomaton {
+    CompiledAutomaton<PTAState> compiled;
+    TimingDomain timingDomain;
+  };
+
   boost::unordered_set<Configuration> configurations;
   PPLRational absTime;
   std::size_t index = 0;
-  Parma_Polyhedra_Library::NNC_Polyhedron elapsePolyhedron;
+  std::unique_ptr<ThreadPool> pool;
+  //! @brief workerAutomata[slot - 1] is used by the worker thread of the slot
+  std::vector<WorkerAutomaton> workerAutomata;
+
+  [[nodiscard]] std::size_t approximateBytes() const {
+    std::size_t bytes = 0;
+    for (const Configuration &conf: configurations) {
+      bytes += sizeof(Configuration) + timingDomain.memoryInBytes(std::get<1>(conf)) +
+               externalMemoryInBytes(std::get<2>(conf)) + std::get<3>(conf).external_memory_in_bytes();
+    }
+    return bytes;
+  }
+
+  /*!
+    @brief Merge the configurations differing only in the number valuation into their convex hull if the
+    configurations after the current event exceed the budget.
+    @throws std::runtime_error If the policy is BudgetPolicy::Abort, or if the configurations still exceed the budget
+    after the merge
+   */
+  void enforceBudget() {
+    budget.record(configurations.size());
+    if (!budget.limits()) {
+      return;
+    }
+    std::size_t bytes = budget.limitsBytes() ? approximateBytes() : 0;
+    if (budget.allows(configurations.size(), bytes)) {
+      return;
+    }
+    budget.exceed(index, configurations.size(), bytes);
+    boost::unordered_map<MergedConfiguration, Symbolic::NumberValuation> hulls;
+    std::size_t merged = 0;
+    for (const Configuration &conf: configurations) {
+      const auto [it, inserted] = hulls.emplace(
+          MergedConfiguration{std::get<0>(conf), std::get<1>(conf), std::get<2>(conf)}, std::get<3>(conf));
+      if (!inserted) {
+        it->second.upper_bound_assign(std::get<3>(conf));
+        ++merged;
+      }
+    }
+    if (budget.counters) {
+      budget.counters->merged += merged;
+    }
+    configurations.clear();
+    for (auto &[key, numberEnv]: hulls) {
+      configurations.insert(
+          std::make_tuple(std::get<0>(key), std::get<1>(key), std::get<2>(key), std::move(numberEnv)));
+    }
+    bytes = budget.limitsBytes() ? approximateBytes() : 0;
+    if (!budget.allows(configurations.size(), bytes)) {
+      MonitorBudget::fail(index, configurations.size(), bytes);
+    }
+  }
+
+  //! @brief Run task(i, slot) for each i in [0, n), in parallel if we have multiple threads.
+  template <typename Task> void forEach(std::size_t n, Task task) {
+    if (pool) {
+      pool->parallelFor(n, task);
+    } else {
+      for (std::size_t i = 0; i < n; ++i) {
+        task(i, 0);
+      }
+    }
+  }
+
+  //! @brief The compiled automaton with the guards owned by the thread of the slot
+  const CompiledAutomaton<PTAState> &localAutomaton(std::size_t slot) const {
+    return slot == 0 ? compiled : workerAutomata[slot - 1].compiled;
+  }
+
+  const TimingDomain &localTimingDomain(std::size_t slot) const {
+    return slot == 0 ? timingDomain : workerAutomata[slot - 1].timingDomain;
+  }
+
+  /*!
+    @brief Try unobservable transitions until the fixpoint.
+
+    @param currentConfigurations The configurations with the dimension for the time elapse
+    @param dwellTime If it is given, the time elapse is bounded by it, and the successors are added to the
+    configurations after the time elapse to the current event.
+   */
+  void unobservableTransitions(boost::unordered_set<Configuration> currentConfigurations,
+                               const std::optional<PPLRational> &dwellTime) {
+    std::vector<Configuration> sources;
+    std::vector<std::vector<UnobservableSuccessor>> successors;
+    while (!currentConfigurations.empty()) {
+      sources.assign(currentConfigurations.begin(), currentConfigurations.end());
+      currentConfigurations.clear();
+      if (successors.size() < sources.size()) {
+        successors.resize(sources.size());
+      }
+      forEach(sources.size(), [&](std::size_t i, std::size_t slot) {
+        successors[i].clear();
+        unobservableSuccessors(sources[i], dwellTime, successors[i], slot);
+      });
+      // Merge the successors in the order of the sources, which is the order of the sequential expansion.
+      for (std::size_t i = 0; i < sources.size(); ++i) {
+        for (UnobservableSuccessor &successor: successors[i]) {
+          currentConfigurations.insert(std::move(successor.configuration));
+          if (successor.match) {
+            notifyObservers(*successor.match);
+          }
+          if (successor.elapsed) {
+            configurations.insert(std::move(*successor.elapsed));
+          }
+        }
+      }
+    }
+  }
+
+  //! @note This is called in the thread of the slot, and it must not modify the monitor.
+  void unobservableSuccessors(const Configuration &conf, const std::optional<PPLRational> &dwellTime,
+                              std::vector<UnobservableSuccessor> &successors, std::size_t slot) const {
+    const auto &localCompiled = localAutomaton(slot);
+    const auto &localDomain = localTimingDomain(slot);
+    const auto edges = localCompiled.edges(std::get<0>(conf), unobservableActinoID);
+    if (edges.empty()) {
+      return;
+    }
+    // make the current env
+    auto clockValuation = std::get<1>(conf);
+    localDomain.elapseUpTo(clockValuation, dwellTime);
+    const auto &stringEnv = std::get<2>(conf);
+    const auto &numberEnv = std::get<3>(conf);
+    for (const auto &edge: edges) {
+      const auto &[transition, target] = edge;
+      // evaluate the guards
+      auto nextCVal = clockValuation;
+      auto nextSEnv = stringEnv;
+      auto nextNEnv = numberEnv;
+      if (localDomain.constrain(nextCVal, localCompiled.edgeIndex(edge), true) &&
+          eval(transition.stringConstraints, nextSEnv, transition.numConstraints, nextNEnv)) {
+        for (const VariableID resetVar: transition.resetVars) {
+          localDomain.reset(nextCVal, resetVar);
+        }
+        transition.update.execute(nextSEnv, nextNEnv);
+        UnobservableSuccessor &successor = successors.emplace_back();
+        successor.configuration = {target, nextCVal, nextSEnv, nextNEnv};
+        if (compiled.isMatch(target)) {
+          successor.match =
+              ParametricMonitorResult{index, absTime, nextNEnv, nextSEnv, localDomain.toPolyhedron(nextCVal)};
+        }
+        if (dwellTime) {
+          // time elapse
+          localDomain.elapseToEvent(nextCVal, *dwellTime);
+          successor.elapsed = Configuration{target, std::move(nextCVal), std::move(nextSEnv), std::move(nextNEnv)};
+        }
+      }
+    }
+  }
+
+  //! @note This is called in the thread of the slot, and it must not modify the monitor.
+  void observableSuccessors(const Configuration &conf, const TimedWordEvent<PPLRational, PPLRational> &event,
+                            std::vector<ObservableSuccessor> &successors, std::size_t slot) const {
+    const std::vector<InternedString> &strings = event.strings;
+    const std::vector<PPLRational> &numbers = event.numbers;
+    const auto &localCompiled = localAutomaton(slot);
+    const auto &localDomain = localTimingDomain(slot);
+    const auto edges = localCompiled.edges(std::get<0>(conf), event.actionId);
+    if (edges.empty()) {
+      return;
+    }
+    // make the current env
+    // The time elapsed in the above
+    const auto &clockValuation = std::get<1>(conf);
+    auto stringEnv = std::get<2>(conf);
+    stringEnv.insert(stringEnv.end(), strings.begin(), strings.end());
+    auto numberEnv = std::get<3>(conf);
+    // add dimension for the data in the timed word.
+    assert(numberEnv.space_dimension() == automaton.numberVariableSize);
+    numberEnv.add_space_dimensions_and_embed(numbers.size());
+    for (std::size_t i = 0; i < numbers.size(); i++) {
+      numberEnv.add_constraint(Parma_Polyhedra_Library::Variable(automaton.numberVariableSize + i) *
+                                   numbers[i].getDenominator() ==
+                               numbers[i].getNumerator());
+    }
+    for (const auto &edge: edges) {
+      const auto &[transition, target] = edge;
+      // evaluate the guards
+      auto nextCVal = clockValuation;
+      auto nextSEnv = stringEnv;
+      auto nextNEnv = numberEnv;
+      if (localDomain.constrain(nextCVal, localCompiled.edgeIndex(edge), false) &&
+          eval(transition.stringConstraints, nextSEnv, transition.numConstraints, nextNEnv)) {
+        for (const VariableID resetVar: transition.resetVars) {
+          localDomain.reset(nextCVal, resetVar);
+        }
+        transition.update.execute(nextSEnv, nextNEnv);
+        nextSEnv.resize(automaton.stringVariableSize);
+        nextNEnv.remove_higher_space_dimensions(automaton.numberVariableSize);
+        successors.push_back({std::make_tuple(target, std::move(nextCVal), std::move(nextSEnv)), std::move(nextNEnv),
+                              compiled.isMatch(target)});
+      }
+    }
+  }
 };
+
+using ParametricMonitor = BasicParametricMonitor<>;
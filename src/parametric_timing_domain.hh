@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "automaton.hh"
+#include "compiled_automaton.hh"
+#include "guard_memo.hh"
+#include "parametric_dbm.hh"
+#include "parametric_timing_constraint.hh"
+#include "ppl_rational.hh"
+
+/*!
+  @name The timing domains of BasicParametricMonitor
+
+  A timing domain represents the sets of the parameter and clock valuations, and it holds the guards of the edges of
+  the compiled automaton in its representation. The dimensions are the parameters followed by the clocks. While the
+  monitor tries the unobservable transitions, a valuation is extended with one more clock for the time elapsed since the
+  previous event.
+
+  @note A domain is used by one thread at a time, and each worker thread of the monitor has its own copy.
+ */
+//! @{
+
+/*!
+  @brief The timing domain by NNC_Polyhedron, which supports any linear guard
+
+  @note PPL may update the internal representation of a polyhedron even in a const operation, e.g., the intersection
+  with a guard. This is why each thread needs its own copy of the guards.
+ */
+class ParametricPolyhedronDomain {
+public:
+  using Valuation = ParametricTimingValuation;
+
+  //! @param guardMemoCapacity The maximum number of the memoized results of the guards, or zero for no memo
+  ParametricPolyhedronDomain(const ParametricTA &automaton, const CompiledAutomaton<PTAState> &compiled,
+                             std::size_t guardMemoCapacity = 0)
+      : parameterSize(automaton.parameterSize), clockSize(automaton.clockVariableSize),
+        elapsePolyhedron(automaton.parameterSize + automaton.clockVariableSize + 1), guardMemo(guardMemoCapacity) {
+    for (std::size_t i = 0; i < parameterSize; i++) {
+      elapsePolyhedron.add_constraint(Parma_Polyhedra_Library::Variable(i) == 0);
+    }
+    for (std::size_t i = parameterSize; i <= parameterSize + clockSize; i++) {
+      elapsePolyhedron.add_constraint(Parma_Polyhedra_Library::Variable(i) == 1);
+    }
+    for (const auto &edge: compiled.allEdges()) {
+      guards.push_back(edge.transition.guard);
+      extendedGuards.push_back(edge.transition.guard);
+      extendedGuards.back().add_space_dimensions_and_embed(1);
+    }
+  }
+
+  //! @brief Returns true because a polyhedron represents any guard and any time elapse.
+  static bool supports(const CompiledAutomaton<PTAState> &, Action) {
+    return true;
+  }
+
+  //! @brief Returns the valuations where all the parameters are non-negative and all the clocks are zero.
+  [[nodiscard]] Valuation initial() const {
+    Valuation initCVal(parameterSize);
+    initCVal.add_space_dimensions_and_project(clockSize);
+    for (std::size_t i = 0; i < parameterSize; i++) {
+      initCVal.add_constraint(Parma_Polyhedra_Library::Variable(i) >= 0);
+    }
+    return initCVal;
+  }
+
+  //! @brief Add the clock for the time elapse, whose value is zero.
+  void extend(Valuation &cval) const {
+    cval.add_space_dimensions_and_project(1);
+  }
+
+  //! @brief Let the duration elapse.
+  void elapse(Valuation &cval, const PPLRational &duration) const {
+    for (std::size_t i = parameterSize; i < parameterSize + clockSize; i++) {
+      //! @todo Currently, the timestamp is mpz (integer). I will make it mpq (quadratic) later.
+      cval.affine_image(Parma_Polyhedra_Library::Variable(i),
+                        Parma_Polyhedra_Library::Variable(i) * duration.getDenominator() + duration.getNumerator(),
+                        duration.getDenominator());
+    }
+  }
+
+  //! @brief Let the time elapse in an extended valuation, at most by the dwell time if it is given.
+  void elapseUpTo(Valuation &cval, const std::optional<PPLRational> &dwellTime) const {
+    assert(cval.space_dimension() == parameterSize + clockSize + 1);
+    cval.time_elapse_assign(elapsePolyhedron);
+    if (dwellTime) {
+      cval.add_constraint(Parma_Polyhedra_Library::Variable(parameterSize + clockSize) * dwellTime->getDenominator() <=
+                          dwellTime->getNumerator());
+    }
+  }
+
+  /*!
+    @brief Intersect the valuation with the guard of the edge, and returns false if the result is empty.
+
+    The results are memoized for the valuations equal to recent ones, e.g., the valuations of the configurations
+    differing only in the string or the number valuation.
+   */
+  bool constrain(Valuation &cval, std::size_t edgeIndex, bool extended) const {
+    return guardMemo.apply(cval, {edgeIndex, extended}, [&](Valuation &polyhedron) {
+      polyhedron.intersection_assign(extended ? extendedGuards[edgeIndex] : guards[edgeIndex]);
+      return !polyhedron.is_empty();
+    });
+  }
+
+  //! @brief Returns the numbers of the guards whose results are memoized and computed.
+  [[nodiscard]] GuardMemoCounters guardMemoCounters() const {
+    return guardMemo.getCounters();
+  }
+
+  void reset(Valuation &cval, VariableID x) const {
+    cval.affine_image(Parma_Polyhedra_Library::Variable(parameterSize + x),
+                      Parma_Polyhedra_Library::Linear_Expression(0));
+  }
+
+  //! @brief Let the time elapse to the current event in an extended valuation, and remove the clock for it.
+  void elapseToEvent(Valuation &cval, const PPLRational &dwellTime) const {
+    for (std::size_t i = parameterSize; i < parameterSize + clockSize; i++) {
+      //! @todo Currently, the timestamp is mpz (integer). I will make it mpq (quadratic) later.
+      cval.affine_image(Parma_Polyhedra_Library::Variable(i),
+                        Parma_Polyhedra_Library::Variable(i) * dwellTime.getDenominator() +
+                            dwellTime.getNumerator() -
+                            Parma_Polyhedra_Library::Variable(parameterSize + clockSize) * dwellTime.getDenominator(),
+                        dwellTime.getDenominator());
+    }
+    cval.remove_higher_space_dimensions(parameterSize + clockSize);
+  }
+
+  //! @brief Returns the approximate heap memory of the valuation.
+  [[nodiscard]] std::size_t memoryInBytes(const Valuation &cval) const {
+    return cval.external_memory_in_bytes();
+  }
+
+  //! @brief Returns the polyhedron of the parameters and the clocks.
+  [[nodiscard]] ParametricTimingValuation toPolyhedron(const Valuation &cval) const {
+    if (cval.space_dimension() == parameterSize + clockSize) {
+      return cval;
+    }
+    auto result = cval;
+    result.remove_higher_space_dimensions(parameterSize + clockSize);
+    return result;
+  }
+
+private:
+  std::size_t parameterSize;
+  std::size_t clockSize;
+  Parma_Polyhedra_Library::NNC_Polyhedron elapsePolyhedron;
+  //! @brief guards[i] is the guard of the i-th edge of the compiled automaton.
+  std::vector<ParametricTimingConstraint> guards;
+  //! @brief The guards with the dimension for the time elapse
+  std::vector<ParametricTimingConstraint> extendedGuards;
+  //! @brief The results of the guards keyed by the index of the edge and whether the valuation is extended
+  mutable GuardMemo<Valuation, std::pair<std::size_t, bool>> guardMemo;
+};
+
+/*!
+  @brief The timing domain by ParametricDBM, which supports the guards of the form x - p ~ c, x ~ c, and p ~ c
+
+  The operations do not use PPL except for the output. Since the timestamps are concrete, the clocks have concrete
+  values and the results are exact as long as the time elapses by the dwell times.
+
+  @note The time elapse of an arbitrary duration, which is needed for the unobservable transitions, can relate a clock
+  and a parameter by their sum, e.g., x + p == 4, which ParametricDBM cannot represent. Thus, the automata with
+  unobservable transitions are not supported, and the operations on the extended valuations are over-approximations.
+ */
+class ParametricDBMDomain {
+public:
+  using Valuation = ParametricDBM;
+
+  //! @note The capacity of the guard memo is ignored because the guards are not memoized.
+  ParametricDBMDomain(const ParametricTA &automaton, const CompiledAutomaton<PTAState> &compiled, std::size_t = 0)
+      : parameterSize(automaton.parameterSize), clockSize(automaton.clockVariableSize) {
+    for (const auto &edge: compiled.allEdges()) {
+      auto guard = ParametricDBM::compile(edge.transition.guard);
+      if (!guard) {
+        throw std::runtime_error("ParametricDBMDomain: a guard is not a conjunction of bounds of differences");
+      }
+      guards.push_back(std::move(*guard));
+    }
+  }
+
+  //! @brief Returns if the automaton has no unobservable transitions and ParametricDBM represents all the guards.
+  static bool supports(const CompiledAutomaton<PTAState> &compiled, Action unobservableAction) {
+    if (compiled.hasAction(unobservableAction)) {
+      return false;
+    }
+    const auto edges = compiled.allEdges();
+    return std::all_of(edges.begin(), edges.end(),
+                       [](const auto &edge) { return ParametricDBM::compile(edge.transition.guard).has_value(); });
+  }
+
+  [[nodiscard]] Valuation initial() const {
+    return ParametricDBM(parameterSize, clockSize);
+  }
+
+  void extend(Valuation &cval) const {
+    cval.addClock();
+  }
+
+  void elapse(Valuation &cval, const PPLRational &duration) const {
+    cval.elapse(duration);
+  }
+
+  void elapseUpTo(Valuation &cval, const std::optional<PPLRational> &dwellTime) const {
+    cval.elapse();
+    if (dwellTime) {
+      cval.constrain(ParametricDBM::Difference{elapseClock(), 0, {*dwellTime, false}});
+    }
+  }
+
+  //! @note The guard does not refer to the clock for the time elapse, so it is the same in an extended valuation.
+  bool constrain(Valuation &cval, std::size_t edgeIndex, bool) const {
+    return cval.constrain(guards[edgeIndex]);
+  }
+
+  //! @brief Returns zero counters because the guards on ParametricDBM are cheap enough not to be memoized.
+  [[nodiscard]] GuardMemoCounters guardMemoCounters() const {
+    return {};
+  }
+
+  void reset(Valuation &cval, VariableID x) const {
+    cval.reset(x);
+  }
+
+  /*!
+    @brief Let the time elapse to the current event in an extended valuation, and remove the clock for it.
+
+    Since the clock for the time elapse is at most the dwell time, this is the time elapse until the clock is the dwell
+    time.
+   */
+  void elapseToEvent(Valuation &cval, const PPLRational &dwellTime) const {
+    cval.elapse();
+    cval.constrain(ParametricDBM::Difference{elapseClock(), 0, {dwellTime, false}});
+    cval.constrain(ParametricDBM::Difference{0, elapseClock(), {-dwellTime, false}});
+    cval.removeClock();
+  }
+
+  [[nodiscard]] std::size_t memoryInBytes(const Valuation &cval) const {
+    return externalMemoryInBytes(cval);
+  }
+
+  [[nodiscard]] ParametricTimingValuation toPolyhedron(const Valuation &cval) const {
+    if (cval.dimension() == parameterSize + clockSize) {
+      return cval.toPolyhedron();
+    }
+    auto projected = cval;
+    projected.removeClock();
+    return projected.toPolyhedron();
+  }
+
+private:
+  std::size_t parameterSize;
+  std::size_t clockSize;
+  //! @brief guards[i] is the guard of the i-th edge of the compiled automaton.
+  std::vector<ParametricDBM::Guard> guards;
+
+  //! @brief The index in the matrix of the clock for the time elapse
+  [[nodiscard]] std::size_t elapseClock() const {
+    return parameterSize + clockSize + 1;
+  }
+};
+//! @}
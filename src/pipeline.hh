@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "observer.hh"
+#include "spsc_queue.hh"
+#include "timed_word_parser.hh"
+
+/*!
+  @brief Forward the results of a monitor to a queue
+ */
+template <typename Result> class QueueObserver : public Observer<Result> {
+public:
+  explicit QueueObserver(SpscQueue<Result> &queue) : queue(queue) {
+  }
+  void notify(const Result &result) override {
+    queue.back() = result;
+    queue.push();
+  }
+
+private:
+  SpscQueue<Result> &queue;
+};
+
+/*!
+  @brief Run the parser, the monitor, and the printer on separate threads.
+
+  The parser fills the event queue on its own thread. The monitor takes the contiguous parsed events from the event
+  queue and processes them by notifyBatch on its own thread, and the results are pushed to the result queue. The
+  printer takes the results on the calling thread. When a queue is full, the stage before it waits (backpressure).
+
+  The monitor is released on its thread after the last event, so the results notified by its destructor (e.g., the
+  unobservable transitions after the last event) are also printed.
+
+  @param monitor The monitor. The pipeline must hold its only reference.
+  @param capacity The capacity of each of the queues
+  @param batchSize The maximum number of the events given to the monitor at once
+  @param makeThreadContext If given, it is called at the start of the parser and monitor threads, and the returned
+  object is kept until the thread stops. For example, PPL requires a Parma_Polyhedra_Library::Thread_Init.
+  @note The results are copied on the monitor thread and read on the calling thread. The PPL objects in the results
+  need PPL built with thread safety.
+  @throws Rethrows the exception thrown by a stage, if any.
+ */
+template <typename Number, typename TimeStamp, typename Monitor, typename Result>
+void runPipeline(AbstractTimedWordParser<Number, TimeStamp> &parser, std::shared_ptr<Monitor> monitor,
+                 Observer<Result> &printer, std::size_t capacity, std::size_t batchSize,
+                 const std::function<std::shared_ptr<void>()> &makeThreadContext = nullptr) {
+  using Event = TimedWordEvent<Number, TimeStamp>;
+  SpscQueue<Event> events(capacity);
+  SpscQueue<Result> results(capacity);
+  monitor->addObserver(std::make_shared<QueueObserver<Result>>(results));
+  std::exception_ptr parserError, monitorError, printerError;
+
+  std::thread parserThread([&] {
+    const auto context = makeThreadContext ? makeThreadContext() : nullptr;
+    try {
+      while (parser.parse(events.back())) {
+        events.push();
+      }
+    } catch (...) {
+      parserError = std::current_exception();
+    }
+    events.close();
+  });
+
+  std::thread monitorThread([&, monitor = std::move(monitor)]() mutable {
+    const auto context = makeThreadContext ? makeThreadContext() : nullptr;
+    Event *data;
+    try {
+      while (std::size_t size = events.front(data)) {
+        size = std::min(size, std::max<std::size_t>(batchSize, 1));
+        monitor->notifyBatch(data, size);
+        events.pop(size);
+      }
+      monitor.reset();
+    } catch (...) {
+      monitorError = std::current_exception();
+      // The monitor is released here so that PPL objects are destroyed before the thread context.
+      if (monitor) {
+        monitor->addObserver(nullptr);
+        monitor.reset();
+      }
+      // Drain the events so that the parser does not wait forever.
+      while (const std::size_t size = events.front(data)) {
+        events.pop(size);
+      }
+    }
+    results.close();
+  });
+
+  Result *data;
+  try {
+    while (const std::size_t size = results.front(data)) {
+      printer.notifyBatch(data, size);
+      results.pop(size);
+    }
+  } catch (...) {
+    printerError = std::current_exception();
+    while (const std::size_t size = results.front(data)) {
+      results.pop(size);
+    }
+  }
+  parserThread.join();
+  monitorThread.join();
+
+  for (const auto &error: {parserError, monitorError, printerError}) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
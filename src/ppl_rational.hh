@@ -1,24 +1,45 @@
 #pragma once
 
+#include <boost/functional/hash.hpp>
+#include <functional>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <ppl.hh>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 /*!
  * @brief Rational coefficient representation for PPL.
+ *
+ * The number is always reduced with a positive denominator. If the numerator and the denominator fit in int64, which
+ * is the case for the timestamps and the data with a fixed number of decimal places, they are held as int64, and the
+ * arithmetic and the comparisons are done in int64. They are converted to Coefficient only when a constraint is built
+ * from them. If an operation overflows, it is redone with Coefficient, and the result is held as Coefficient unless it
+ * fits in int64 again.
  */
 class PPLRational {
 private:
-  Parma_Polyhedra_Library::Coefficient numerator;
-  Parma_Polyhedra_Library::Coefficient denominator;
+  using Coefficient = Parma_Polyhedra_Library::Coefficient;
+
+  //! @brief The numerator and the denominator if they fit in int64
+  std::int64_t smallNumerator = 0;
+  std::int64_t smallDenominator = 1;
+  //! @brief The numerator and the denominator if they do not fit in int64. It is immutable and shared by the copies.
+  std::shared_ptr<const std::pair<Coefficient, Coefficient>> big;
 
   /*!
    * @brief Compute the greatest common divisor (GCD) of two coefficients with
    * the Euclidean algorithm.
    */
-  static Parma_Polyhedra_Library::Coefficient gcd(Parma_Polyhedra_Library::Coefficient a,
-                                                  Parma_Polyhedra_Library::Coefficient b) {
+  static Coefficient gcd(Coefficient a, Coefficient b) {
     while (b != 0) {
-      Parma_Polyhedra_Library::Coefficient temp = b;
+      Coefficient temp = b;
       b = a % b;
       a = temp;
     }
@@ -26,64 +47,195 @@ private:
     return a < 0 ? -a : a;
   }
 
-protected:
-  /*
-   * @brief Reduce the rational number to its simplest form.
-   */
-  void reduce() {
-    if (denominator < 0) {
-      numerator = -numerator;
-      denominator = -denominator;
+  template <typename T, typename = void> struct HasGetSi : std::false_type {};
+  template <typename T> struct HasGetSi<T, std::void_t<decltype(std::declval<T>().get_si())>> : std::true_type {};
+
+  //! @brief Returns the coefficient as int64, or std::nullopt if it does not fit.
+  template <typename T> static std::optional<std::int64_t> toInt64(const T &c) {
+    if (c < std::numeric_limits<std::int64_t>::min() || c > std::numeric_limits<std::int64_t>::max()) {
+      return std::nullopt;
+    }
+    if constexpr (std::is_integral_v<T>) {
+      return static_cast<std::int64_t>(c);
+    } else if constexpr (HasGetSi<T>::value) {
+      // GMP integers
+      return c.get_si();
+    } else {
+      // The checked integers of PPL
+      return raw_value(c);
+    }
+  }
+
+  //! @brief Set the number to n / d in int64, and returns false if the reduction overflows.
+  bool assignSmall(std::int64_t n, std::int64_t d) {
+    if (n == std::numeric_limits<std::int64_t>::min() || d == std::numeric_limits<std::int64_t>::min()) {
+      return false;
+    }
+    if (d < 0) {
+      n = -n;
+      d = -d;
     }
+    const std::int64_t g = std::gcd(n, d);
+    smallNumerator = n / g;
+    smallDenominator = d / g;
+    big.reset();
+    return true;
+  }
 
-    const Parma_Polyhedra_Library::Coefficient gcd = this->gcd(numerator, denominator);
+  void assign(Coefficient n, Coefficient d) {
+    if (d == 0) {
+      throw std::invalid_argument("Denominator cannot be zero.");
+    }
+    if (const auto sn = toInt64(n), sd = toInt64(d); sn && sd && assignSmall(*sn, *sd)) {
+      return;
+    }
+    if (d < 0) {
+      n = -n;
+      d = -d;
+    }
+    const Coefficient g = gcd(n, d);
+    if (g != 0 && g != 1) {
+      n /= g;
+      d /= g;
+    }
+    if (const auto sn = toInt64(n), sd = toInt64(d); sn && sd && assignSmall(*sn, *sd)) {
+      return;
+    }
+    big = std::make_shared<const std::pair<Coefficient, Coefficient>>(std::move(n), std::move(d));
+  }
 
-    if (gcd != 0 && gcd != 1) {
-      numerator /= gcd;
-      denominator /= gcd;
+  //! @brief Compute a + b, or a - b if subtract, in int64, and returns false if it overflows.
+  static bool addSmall(const PPLRational &a, const PPLRational &b, bool subtract, PPLRational &result) {
+    std::int64_t left = a.smallNumerator, right = b.smallNumerator, den = a.smallDenominator, num;
+    if (a.smallDenominator != b.smallDenominator &&
+        (__builtin_mul_overflow(a.smallNumerator, b.smallDenominator, &left) ||
+         __builtin_mul_overflow(b.smallNumerator, a.smallDenominator, &right) ||
+         __builtin_mul_overflow(a.smallDenominator, b.smallDenominator, &den))) {
+      return false;
     }
+    if (subtract ? __builtin_sub_overflow(left, right, &num) : __builtin_add_overflow(left, right, &num)) {
+      return false;
+    }
+    return result.assignSmall(num, den);
   }
 
 public:
-  PPLRational() : numerator(0), denominator(1) {
+  PPLRational() = default;
+
+  PPLRational(int c) : smallNumerator(c) {
   }
 
-  PPLRational(int c) : numerator(c), denominator(1) {
+  PPLRational(Coefficient numerator, Coefficient denominator) {
+    assign(std::move(numerator), std::move(denominator));
   }
 
-  PPLRational(Parma_Polyhedra_Library::Coefficient numerator, Parma_Polyhedra_Library::Coefficient denominator)
-      : numerator(numerator), denominator(denominator) {
-    if (denominator == 0) {
-      throw std::invalid_argument("Denominator cannot be zero.");
+  //! @brief Returns numerator / denominator computed in int64 if possible.
+  static PPLRational fromInt64(std::int64_t numerator, std::int64_t denominator) {
+    PPLRational result;
+    if (denominator == 0 || !result.assignSmall(numerator, denominator)) {
+      result.assign(numerator, denominator);
     }
-    reduce();
+    return result;
+  }
+
+  //! @brief Returns if the numerator and the denominator are held as int64.
+  [[nodiscard]] bool isSmall() const {
+    return !big;
+  }
+
+  //! @pre isSmall()
+  [[nodiscard]] std::int64_t getSmallNumerator() const {
+    return smallNumerator;
   }
 
-  Parma_Polyhedra_Library::Coefficient getNumerator() const {
-    return numerator;
+  //! @pre isSmall()
+  [[nodiscard]] std::int64_t getSmallDenominator() const {
+    return smallDenominator;
   }
 
-  Parma_Polyhedra_Library::Coefficient getDenominator() const {
-    return denominator;
+  Coefficient getNumerator() const {
+    return big ? big->first : Coefficient(smallNumerator);
+  }
+
+  Coefficient getDenominator() const {
+    return big ? big->second : Coefficient(smallDenominator);
   }
 
   /*
    * @brief Unary negation.
    */
   PPLRational operator-() const {
-    return PPLRational(-numerator, denominator);
+    PPLRational result;
+    if (!big && result.assignSmall(-smallNumerator, smallDenominator)) {
+      return result;
+    }
+    return PPLRational(-getNumerator(), getDenominator());
+  }
+
+  /*
+   * @brief Addition between two rationals.
+   */
+  PPLRational operator+(const PPLRational &other) const {
+    PPLRational result;
+    if (!big && !other.big && addSmall(*this, other, false, result)) {
+      return result;
+    }
+    const Coefficient num = getNumerator() * other.getDenominator() + other.getNumerator() * getDenominator();
+    const Coefficient den = getDenominator() * other.getDenominator();
+    return PPLRational(num, den);
   }
 
   /*
    * @brief Subtraction between two rationals.
    */
   PPLRational operator-(const PPLRational &other) const {
-    const Parma_Polyhedra_Library::Coefficient num = numerator * other.denominator - other.numerator * denominator;
-    const Parma_Polyhedra_Library::Coefficient den = denominator * other.denominator;
+    PPLRational result;
+    if (!big && !other.big && addSmall(*this, other, true, result)) {
+      return result;
+    }
+    const Coefficient num = getNumerator() * other.getDenominator() - other.getNumerator() * getDenominator();
+    const Coefficient den = getDenominator() * other.getDenominator();
     return PPLRational(num, den);
   }
 };
 
+/*!
+ * @brief The digits of a decimal number, accumulated in int64 while they fit and in Coefficient afterwards
+ */
+class PPLRationalDigits {
+public:
+  void push(int digit, bool fractional) {
+    if (!overflowed) {
+      std::int64_t n, d = smallDenominator;
+      if (!__builtin_mul_overflow(smallNumerator, 10, &n) && !__builtin_add_overflow(n, digit, &n) &&
+          (!fractional || !__builtin_mul_overflow(smallDenominator, 10, &d))) {
+        smallNumerator = n;
+        smallDenominator = d;
+        return;
+      }
+      overflowed = true;
+      numerator = smallNumerator;
+      denominator = smallDenominator;
+    }
+    numerator = numerator * 10 + digit;
+    if (fractional) {
+      denominator *= 10;
+    }
+  }
+
+  [[nodiscard]] PPLRational value(bool isNegative) const {
+    if (!overflowed) {
+      return PPLRational::fromInt64(isNegative ? -smallNumerator : smallNumerator, smallDenominator);
+    }
+    return PPLRational(isNegative ? -numerator : numerator, denominator);
+  }
+
+private:
+  std::int64_t smallNumerator = 0, smallDenominator = 1;
+  bool overflowed = false;
+  Parma_Polyhedra_Library::Coefficient numerator, denominator;
+};
+
 static inline std::ostream &operator<<(std::ostream &os, const PPLRational &r) {
   if (r.getDenominator() == 1) {
     os << r.getNumerator();
@@ -140,11 +292,9 @@ static inline std::ostream &operator<<(std::ostream &os, const PPLRational &r) {
  * @brief Read a rational number from its decimal representation (e.g., "-1.05" or ".2").
  */
 static inline std::istream &operator>>(std::istream &is, PPLRational &r) {
-  Parma_Polyhedra_Library::Coefficient numerator, denominator;
+  PPLRationalDigits digits;
   bool isNegative = false;
   bool lessThanOne = false;
-  numerator = 0;
-  denominator = 1;
   char ch;
   // Skip leading whitespace
   is >> std::ws;
@@ -170,28 +320,96 @@ static inline std::istream &operator>>(std::istream &is, PPLRational &r) {
         lessThanOne = true;
       }
     } else if (isdigit(ch)) {
-      numerator = numerator * 10 + (ch - '0');
-      if (lessThanOne) {
-        denominator *= 10;
-      }
+      digits.push(ch - '0', lessThanOne);
     } else {
       throw std::runtime_error("Unexpected character encountered while parsing rational number.");
     }
     c = is.peek();
   }
   
-  r = PPLRational(isNegative ? -numerator : numerator, denominator);
+  r = digits.value(isNegative);
   return is;
 }
 
+/*!
+ * @brief Read a rational number from the entire token in its decimal representation (e.g., "-1.05" or ".2").
+ *
+ * @retval true If the entire token represents a rational number
+ * @sa MmapTimedWordParser
+ */
+static inline bool fromChars(std::string_view token, PPLRational &r) {
+  PPLRationalDigits digits;
+  bool isNegative = false;
+  bool lessThanOne = false;
+  if (!token.empty() && (token.front() == '-' || token.front() == '+')) {
+    isNegative = token.front() == '-';
+    token.remove_prefix(1);
+  }
+  if (token.empty()) {
+    return false;
+  }
+  for (const char ch: token) {
+    if (ch == '.') {
+      if (lessThanOne) {
+        // Second decimal point encountered, invalid input
+        return false;
+      }
+      lessThanOne = true;
+    } else if (isdigit(ch)) {
+      digits.push(ch - '0', lessThanOne);
+    } else {
+      return false;
+    }
+  }
+
+  r = digits.value(isNegative);
+  return true;
+}
+
+//! @note Since the rational numbers are reduced, the equal ones held as int64 have the same numerator and denominator.
 static inline bool operator==(const PPLRational &lhs, const PPLRational &rhs) {
+  if (lhs.isSmall() && rhs.isSmall()) {
+    return lhs.getSmallNumerator() == rhs.getSmallNumerator() &&
+           lhs.getSmallDenominator() == rhs.getSmallDenominator();
+  }
   return lhs.getNumerator() * rhs.getDenominator() == rhs.getNumerator() * lhs.getDenominator();
 }
 
+//! @note The denominators are positive after the reduction.
+static inline bool operator<(const PPLRational &lhs, const PPLRational &rhs) {
+  std::int64_t left, right;
+  if (lhs.isSmall() && rhs.isSmall() &&
+      !__builtin_mul_overflow(lhs.getSmallNumerator(), rhs.getSmallDenominator(), &left) &&
+      !__builtin_mul_overflow(rhs.getSmallNumerator(), lhs.getSmallDenominator(), &right)) {
+    return left < right;
+  }
+  return lhs.getNumerator() * rhs.getDenominator() < rhs.getNumerator() * lhs.getDenominator();
+}
+
 static inline bool operator==(const PPLRational &lhs, const int &rhs) {
+  if (lhs.isSmall()) {
+    return lhs.getSmallDenominator() == 1 && lhs.getSmallNumerator() == rhs;
+  }
   return lhs.getNumerator() == lhs.getDenominator() * rhs;
 }
 
 static inline bool operator==(const int &lhs, const PPLRational &rhs) {
   return rhs == lhs;
 }
+
+/*!
+ * @note The rational numbers are reduced, and thus the equal numbers have the same numerator and denominator.
+ * @note A number is held as int64 if and only if its reduced numerator and denominator fit in int64 and the
+ * numerator is not the minimum of int64, whatever operation computes it. Therefore, the equal numbers have the same
+ * representation, and we hash the int64 ones without Coefficient.
+ */
+static inline std::size_t hash_value(const PPLRational &r) {
+  if (r.isSmall()) {
+    std::size_t seed = std::hash<std::int64_t>{}(r.getSmallNumerator());
+    boost::hash_combine(seed, r.getSmallDenominator());
+    return seed;
+  }
+  std::size_t seed = std::hash<Parma_Polyhedra_Library::Coefficient>{}(r.getNumerator());
+  boost::hash_combine(seed, std::hash<Parma_Polyhedra_Library::Coefficient>{}(r.getDenominator()));
+  return seed;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+/*!
+  @brief If PPL is built with thread safety, i.e., configured with --enable-thread-safe
+
+  SYMON_PPL_THREAD_SAFE is defined by CMake if ppl.hh defines PPL_THREAD_SAFE. Otherwise, PPL shares its temporaries
+  among the threads, and the PPL objects must be used by one thread even if each thread has its own objects.
+ */
+#ifdef SYMON_PPL_THREAD_SAFE
+constexpr bool pplThreadSafe = true;
+#else
+constexpr bool pplThreadSafe = false;
+#endif
@@ -1,75 +1,474 @@
-#include <iomanip>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
 
+#include "binary_result.hh"
 #include "boolean_monitor.hh"
+#include "output_buffer.hh"
 
+//! @brief The format of the results printed by the printers
+enum class OutputFormat {
+  //! @brief The tab-separated text
+  Text,
+  //! @brief The records of BinaryResult
+  Binary
+};
+
+/*!
+  @brief Sort the interned strings lexicographically for printing.
+
+  @note The strings in Symbolic::StringValuation are sorted by their ids.
+  @param sorted The result. It is reused so that no memory is allocated for each match.
+ */
+static inline void sortStrings(const std::vector<InternedString> &strings, std::vector<const std::string *> &sorted) {
+  sorted.clear();
+  for (const InternedString str: strings) {
+    sorted.push_back(&str.str());
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const std::string *lhs, const std::string *rhs) { return *lhs < *rhs; });
+}
+
+//! @brief Returns the result of the Boolean monitor in the record, e.g., to print it as text.
+template <class Number> BooleanMonitorResult<Number> decodeBooleanResult(const BinaryResult::Record &record) {
+  BooleanMonitorResult<Number> result{record.index, record.timestamp, {}, {}};
+  for (const std::optional<double> &value: record.numberValuation) {
+    result.numberValuation.emplace_back(value ? std::optional<Number>(static_cast<Number>(*value)) : std::nullopt);
+  }
+  for (const BinaryResult::StringValue &value: record.stringValuation) {
+    if (value.kind == BinaryResult::StringKind::Equal) {
+      result.stringValuation.emplace_back(InternedString(value.strings.front()));
+    } else {
+      result.stringValuation.emplace_back(std::nullopt);
+    }
+  }
+  return result;
+}
+
+/*!
+  @name The printers of the results of the monitors
+
+  A printer formats each match into its OutputBuffer, which is passed to the standard output when it is full and after
+  each batch of the matches. In OutputFormat::Binary, the printer writes the header of BinaryResult on construction and
+  a record for each match. In OutputFormat::Text, printRecord() prints a record of BinaryResult as the same text as the
+  original match.
+ */
+//! @{
 template <class Number> struct BooleanPrinter : public Observer<BooleanMonitorResult<Number>> {
-  BooleanPrinter() = default;
+  explicit BooleanPrinter(OutputFormat format = OutputFormat::Text, std::ostream &os = std::cout)
+      : format(format), out(os) {
+    if (format == OutputFormat::Binary) {
+      encoder.header(BinaryResult::Kind::Boolean);
+      out.write(encoder.data());
+    }
+  }
 
   virtual ~BooleanPrinter() = default;
 
   void notify(const BooleanMonitorResult<Number> &result) override {
-    std::cout << "@" << std::fixed << result.timestamp << std::defaultfloat << ".\t(time-point " << result.index << ")\t";
+    if (format == OutputFormat::Binary) {
+      encoder.beginRecord();
+      encoder.putU64(result.index);
+      encoder.putF64(result.timestamp);
+      encoder.putU32(result.stringValuation.size());
+      for (const auto &value: result.stringValuation) {
+        if (value) {
+          encoder.putU8(static_cast<std::uint8_t>(BinaryResult::StringKind::Equal));
+          encoder.putString(value->str());
+        } else {
+          encoder.putU8(static_cast<std::uint8_t>(BinaryResult::StringKind::Unset));
+        }
+      }
+      encoder.putU32(result.numberValuation.size());
+      for (const auto &value: result.numberValuation) {
+        encoder.putU8(value.has_value());
+        if (value) {
+          encoder.putF64(static_cast<double>(*value));
+        }
+      }
+      encoder.endRecord();
+      out.write(encoder.data());
+      return;
+    }
+    out.put('@').writeFixed(result.timestamp).write(".\t(time-point ").writeInteger(result.index).write(")\t");
     for (std::size_t i = 0; i < result.stringValuation.size(); i++) {
       if (result.stringValuation[i]) {
-        std::cout << 'x' << i << " == " << result.stringValuation[i]->c_str() << '\t';
+        out.put('x').writeInteger(i).write(" == ").write(result.stringValuation[i]->str()).put('\t');
       }
     }
 
     for (std::size_t i = 0; i < result.numberValuation.size(); i++) {
-      std::cout << "x" << i << " == " << *(result.numberValuation[i]) << "\t";
+      out.put('x').writeInteger(i).write(" == ").writeNumber(*(result.numberValuation[i])).put('\t');
+    }
+    out.put('\n');
+  }
+
+  void notifyBatch(const BooleanMonitorResult<Number> *data, std::size_t size) override {
+    for (std::size_t i = 0; i < size; ++i) {
+      notify(data[i]);
     }
-    printf("\n");
+    out.drain();
+  }
+
+  //! @pre The format is OutputFormat::Text.
+  void printRecord(const BinaryResult::Record &record) {
+    notify(decodeBooleanResult<Number>(record));
   }
+
+private:
+  OutputFormat format;
+  OutputBuffer out;
+  BinaryResult::Encoder encoder;
 };
 
 #include "data_parametric_monitor.hh"
 
+/*!
+  @brief Print the string valuation of a symbolic monitor, e.g., "x0 != {a, b, }\tx1 == c\t".
+
+  @param sorted The storage reused to sort the strings
+ */
+static inline void printStringValuation(OutputBuffer &out, const Symbolic::StringValuation &stringValuation,
+                                        std::vector<const std::string *> &sorted) {
+  for (std::size_t i = 0; i < stringValuation.size(); i++) {
+    if (stringValuation[i].index() == 0) {
+      out.put('x').writeInteger(i).write(" != {");
+      sortStrings(std::get<0>(stringValuation[i]), sorted);
+      for (const std::string *r: sorted) {
+        out.write(*r).write(", ");
+      }
+      out.write("}\t");
+    } else {
+      out.put('x').writeInteger(i).write(" == ").write(std::get<1>(stringValuation[i]).str()).put('\t');
+    }
+  }
+}
+
+//! @brief Print the string valuation in a record of BinaryResult as printStringValuation() prints the original one.
+static inline void printStringValuation(OutputBuffer &out, const std::vector<BinaryResult::StringValue> &values) {
+  for (std::size_t i = 0; i < values.size(); i++) {
+    switch (values[i].kind) {
+      case BinaryResult::StringKind::NotIn:
+        // The strings are sorted by the encoder.
+        out.put('x').writeInteger(i).write(" != {");
+        for (const std::string &r: values[i].strings) {
+          out.write(r).write(", ");
+        }
+        out.write("}\t");
+        break;
+      case BinaryResult::StringKind::Equal:
+        out.put('x').writeInteger(i).write(" == ").write(values[i].strings.front()).put('\t');
+        break;
+      case BinaryResult::StringKind::Unset:
+        break;
+    }
+  }
+}
+
+/*!
+  @brief Encode the string valuation of a symbolic monitor in BinaryResult.
+
+  @param sorted The storage reused to sort the strings
+ */
+static inline void encodeStringValuation(BinaryResult::Encoder &encoder,
+                                         const Symbolic::StringValuation &stringValuation,
+                                         std::vector<const std::string *> &sorted) {
+  encoder.putU32(stringValuation.size());
+  for (const auto &value: stringValuation) {
+    if (value.index() == 0) {
+      encoder.putU8(static_cast<std::uint8_t>(BinaryResult::StringKind::NotIn));
+      sortStrings(std::get<0>(value), sorted);
+      encoder.putU32(sorted.size());
+      for (const std::string *r: sorted) {
+        encoder.putString(*r);
+      }
+    } else {
+      encoder.putU8(static_cast<std::uint8_t>(BinaryResult::StringKind::Equal));
+      encoder.putString(std::get<1>(value).str());
+    }
+  }
+}
+
+/*!
+  @brief Encode the integer in BinaryResult.
+
+  @param digits The stream reused to print the integer
+ */
+static inline void encodeInteger(BinaryResult::Encoder &encoder, const Parma_Polyhedra_Library::Coefficient &integer,
+                                 std::ostringstream &digits) {
+  digits.str(std::string());
+  digits << integer;
+  encoder.putString(digits.str());
+}
+
+//! @brief Encode the minimized constraints of the polyhedron in BinaryResult.
+static inline void encodePolyhedron(BinaryResult::Encoder &encoder,
+                                    const Parma_Polyhedra_Library::NNC_Polyhedron &polyhedron,
+                                    std::ostringstream &digits) {
+  const auto dimension = polyhedron.space_dimension();
+  encoder.putU32(dimension);
+  const bool empty = polyhedron.is_empty();
+  encoder.putU8(empty);
+  if (empty) {
+    encoder.putU32(0);
+    return;
+  }
+  const auto &constraints = polyhedron.minimized_constraints();
+  encoder.putU32(std::distance(constraints.begin(), constraints.end()));
+  for (const auto &constraint: constraints) {
+    auto relation = BinaryResult::Relation::GreaterEqual;
+    if (constraint.is_equality()) {
+      relation = BinaryResult::Relation::Equal;
+    } else if (constraint.is_strict_inequality()) {
+      relation = BinaryResult::Relation::Greater;
+    }
+    encoder.putU8(static_cast<std::uint8_t>(relation));
+    // A constraint may have a smaller dimension than the polyhedron.
+    for (std::size_t i = 0; i < dimension; ++i) {
+      encodeInteger(encoder,
+                    i < constraint.space_dimension() ? constraint.coefficient(Parma_Polyhedra_Library::Variable(i))
+                                                     : Parma_Polyhedra_Library::Coefficient(0),
+                    digits);
+    }
+    encodeInteger(encoder, constraint.inhomogeneous_term(), digits);
+  }
+}
+
+/*!
+  @brief Returns the integer of the decimal digits in BinaryResult.
+
+  @throws std::runtime_error If it is not an integer
+ */
+static inline Parma_Polyhedra_Library::Coefficient decodeInteger(const std::string &digits) {
+  const bool isNegative = !digits.empty() && digits.front() == '-';
+  if (digits.size() == std::size_t{isNegative}) {
+    throw std::runtime_error("BinaryResult: malformed integer");
+  }
+  Parma_Polyhedra_Library::Coefficient integer = 0;
+  for (std::size_t i = isNegative; i < digits.size(); ++i) {
+    if (digits[i] < '0' || digits[i] > '9') {
+      throw std::runtime_error("BinaryResult: malformed integer");
+    }
+    integer *= 10;
+    integer += digits[i] - '0';
+  }
+  return isNegative ? Parma_Polyhedra_Library::Coefficient(-integer) : integer;
+}
+
+static inline Symbolic::StringValuation decodeStringValuation(const std::vector<BinaryResult::StringValue> &values) {
+  Symbolic::StringValuation stringValuation;
+  stringValuation.reserve(values.size());
+  for (const BinaryResult::StringValue &value: values) {
+    if (value.kind == BinaryResult::StringKind::Equal) {
+      stringValuation.emplace_back(InternedString(value.strings.front()));
+    } else {
+      stringValuation.emplace_back(std::vector<InternedString>(value.strings.begin(), value.strings.end()));
+    }
+  }
+  return stringValuation;
+}
+
+static inline Parma_Polyhedra_Library::Constraint decodeConstraint(const BinaryResult::Constraint &constraint) {
+  Parma_Polyhedra_Library::Linear_Expression expression(decodeInteger(constraint.inhomogeneousTerm));
+  for (std::size_t i = 0; i < constraint.coefficients.size(); ++i) {
+    expression += decodeInteger(constraint.coefficients[i]) *
+                  Parma_Polyhedra_Library::Linear_Expression(Parma_Polyhedra_Library::Variable(i));
+  }
+  switch (constraint.relation) {
+    case BinaryResult::Relation::Equal:
+      return expression == 0;
+    case BinaryResult::Relation::GreaterEqual:
+      return expression >= 0;
+    case BinaryResult::Relation::Greater:
+      break;
+  }
+  return expression > 0;
+}
+
+/*!
+  @brief Returns the polyhedron in BinaryResult.
+
+  @note The polyhedron is equal to the original one, but its minimized constraints may be in another order. To print
+  the same text as the original one, use printPolyhedron() on the record.
+ */
+static inline Parma_Polyhedra_Library::NNC_Polyhedron decodePolyhedron(const BinaryResult::Polyhedron &polyhedron) {
+  if (polyhedron.empty) {
+    return Parma_Polyhedra_Library::NNC_Polyhedron(polyhedron.dimension, Parma_Polyhedra_Library::EMPTY);
+  }
+  Parma_Polyhedra_Library::NNC_Polyhedron result(polyhedron.dimension);
+  for (const BinaryResult::Constraint &constraint: polyhedron.constraints) {
+    result.add_constraint(decodeConstraint(constraint));
+  }
+  return result;
+}
+
+//! @brief Print the polyhedron by PPL, i.e., "false" if it is empty, or its minimized constraints or "true" otherwise.
+static inline void printPolyhedron(OutputBuffer &out, const Parma_Polyhedra_Library::NNC_Polyhedron &polyhedron) {
+  using Parma_Polyhedra_Library::IO_Operators::operator<<;
+  out.stream() << polyhedron;
+}
+
+/*!
+  @brief Print the polyhedron in a record of BinaryResult as printPolyhedron() prints the original one.
+
+  The record has the minimized constraints of the original polyhedron in their order, and they are printed one by one
+  in the same way as PPL prints a polyhedron.
+ */
+static inline void printPolyhedron(OutputBuffer &out, const BinaryResult::Polyhedron &polyhedron) {
+  using Parma_Polyhedra_Library::IO_Operators::operator<<;
+  if (polyhedron.empty) {
+    out.write("false");
+    return;
+  }
+  if (polyhedron.constraints.empty()) {
+    out.write("true");
+    return;
+  }
+  for (std::size_t i = 0; i < polyhedron.constraints.size(); ++i) {
+    if (i > 0) {
+      out.write(", ");
+    }
+    out.stream() << decodeConstraint(polyhedron.constraints[i]);
+  }
+}
+
+//! @brief Returns the result of the data-parametric monitor in the record. To print it as text, use printRecord().
+static inline DataParametricMonitorResult decodeDataParametricResult(const BinaryResult::Record &record) {
+  return {record.index, record.timestamp, decodePolyhedron(record.numberPolyhedron),
+          decodeStringValuation(record.stringValuation)};
+}
+
 struct DataParametricPrinter : public Observer<DataParametricMonitorResult> {
-  DataParametricPrinter() = default;
+  explicit DataParametricPrinter(OutputFormat format = OutputFormat::Text, std::ostream &os = std::cout)
+      : format(format), out(os) {
+    if (format == OutputFormat::Binary) {
+      encoder.header(BinaryResult::Kind::DataParametric);
+      out.write(encoder.data());
+    }
+  }
 
   virtual ~DataParametricPrinter() = default;
 
   void notify(const DataParametricMonitorResult &result) override {
-    using Parma_Polyhedra_Library::IO_Operators::operator<<;
-    std::cout << "@" << std::fixed << result.timestamp << ".\t(time-point " << result.index << ")\t";
-    for (std::size_t i = 0; i < result.stringValuation.size(); i++) {
-      if (result.stringValuation[i].index() == 0) {
-        std::cout << "x" << i << " != {";
-        for (const auto &r: std::get<0>(result.stringValuation[i])) {
-          std::cout << r << ", ";
-        }
-        std::cout << "}\t";
-      } else {
-        std::cout << "x" << i << " == " << std::get<1>(result.stringValuation[i]) << "\t";
-      }
+    if (format == OutputFormat::Binary) {
+      encoder.beginRecord();
+      encoder.putU64(result.index);
+      encoder.putF64(result.timestamp);
+      encodeStringValuation(encoder, result.stringValuation, sorted);
+      encodePolyhedron(encoder, result.numberValuation, digits);
+      encoder.endRecord();
+      out.write(encoder.data());
+      return;
+    }
+    printTimePoint(result.timestamp, result.index);
+    printStringValuation(out, result.stringValuation, sorted);
+    printPolyhedron(out, result.numberValuation);
+    out.put('\n');
+  }
+
+  void notifyBatch(const DataParametricMonitorResult *data, std::size_t size) override {
+    for (std::size_t i = 0; i < size; ++i) {
+      notify(data[i]);
     }
+    out.drain();
+  }
 
-    std::cout << result.numberValuation << "\n";
+  //! @pre The format is OutputFormat::Text.
+  void printRecord(const BinaryResult::Record &record) {
+    printTimePoint(record.timestamp, record.index);
+    printStringValuation(out, record.stringValuation);
+    printPolyhedron(out, record.numberPolyhedron);
+    out.put('\n');
+  }
+
+private:
+  OutputFormat format;
+  OutputBuffer out;
+  std::vector<const std::string *> sorted;
+  BinaryResult::Encoder encoder;
+  std::ostringstream digits;
+
+  void printTimePoint(double timestamp, std::size_t index) {
+    out.put('@').writeFixed(timestamp).write(".\t(time-point ").writeInteger(index).write(")\t");
   }
 };
 
 #include "parametric_monitor.hh"
 
 struct ParametricPrinter : public Observer<ParametricMonitorResult> {
-  ParametricPrinter() = default;
+  explicit ParametricPrinter(OutputFormat format = OutputFormat::Text, std::ostream &os = std::cout)
+      : format(format), out(os) {
+    if (format == OutputFormat::Binary) {
+      encoder.header(BinaryResult::Kind::Parametric);
+      out.write(encoder.data());
+    }
+  }
 
   virtual ~ParametricPrinter() = default;
 
   void notify(const ParametricMonitorResult &result) override {
-    using Parma_Polyhedra_Library::IO_Operators::operator<<;
-    std::cout << "@" << result.timestamp << ".\t(time-point " << result.index << ")\t";
-    for (std::size_t i = 0; i < result.stringValuation.size(); i++) {
-      if (result.stringValuation[i].index() == 0) {
-        std::cout << "x" << i << " != {";
-        for (const auto &r: std::get<0>(result.stringValuation[i])) {
-          std::cout << r << ", ";
-        }
-        std::cout << "}\t";
-      } else {
-        std::cout << "x" << i << " == " << std::get<1>(result.stringValuation[i]) << "\t";
-      }
+    if (format == OutputFormat::Binary) {
+      encoder.beginRecord();
+      encoder.putU64(result.index);
+      encodeInteger(encoder, result.timestamp.getNumerator(), digits);
+      encodeInteger(encoder, result.timestamp.getDenominator(), digits);
+      encodeStringValuation(encoder, result.stringValuation, sorted);
+      encodePolyhedron(encoder, result.numberValuation, digits);
+      encodePolyhedron(encoder, result.parametricTimingValuation, digits);
+      encoder.endRecord();
+      out.write(encoder.data());
+      return;
+    }
+    printTimePoint(result.timestamp, result.index);
+    printStringValuation(out, result.stringValuation, sorted);
+    out.write("Num: ");
+    printPolyhedron(out, result.numberValuation);
+    out.write("\tClock: ");
+    printPolyhedron(out, result.parametricTimingValuation);
+    out.put('\n');
+  }
+
+  void notifyBatch(const ParametricMonitorResult *data, std::size_t size) override {
+    for (std::size_t i = 0; i < size; ++i) {
+      notify(data[i]);
     }
+    out.drain();
+  }
 
-    std::cout << "Num: " << result.numberValuation << "\tClock: " << result.parametricTimingValuation << "\n";
+  //! @pre The format is OutputFormat::Text.
+  void printRecord(const BinaryResult::Record &record) {
+    printTimePoint(PPLRational(decodeInteger(record.timestampNumerator), decodeInteger(record.timestampDenominator)),
+                   record.index);
+    printStringValuation(out, record.stringValuation);
+    out.write("Num: ");
+    printPolyhedron(out, record.numberPolyhedron);
+    out.write("\tClock: ");
+    printPolyhedron(out, record.timingPolyhedron);
+    out.put('\n');
+  }
+
+private:
+  OutputFormat format;
+  OutputBuffer out;
+  std::vector<const std::string *> sorted;
+  BinaryResult::Encoder encoder;
+  std::ostringstream digits;
+
+  void printTimePoint(const PPLRational &timestamp, std::size_t index) {
+    out.put('@');
+    if (timestamp.isSmall() && timestamp.getSmallDenominator() == 1) {
+      out.writeInteger(timestamp.getSmallNumerator());
+    } else {
+      out.stream() << timestamp;
+    }
+    out.write(".\t(time-point ").writeInteger(index).write(")\t");
   }
 };
+
+//! @brief Returns the result of the parametric monitor in the record. To print it as text, use printRecord().
+static inline ParametricMonitorResult decodeParametricResult(const BinaryResult::Record &record) {
+  return {record.index,
+          PPLRational(decodeInteger(record.timestampNumerator), decodeInteger(record.timestampDenominator)),
+          decodePolyhedron(record.numberPolyhedron), decodeStringValuation(record.stringValuation),
+          decodePolyhedron(record.timingPolyhedron)};
+}
+//! @}
@@ -1,15 +1,29 @@
 #pragma once
 
+#include <cstdint>
 #include <fstream>
 #include <istream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 /*!
   @brief Signature of input data
+
+  @note The actions are looked up with a perfect hash table built when the signature is loaded. Each lookup of an
+  action name hashes it once, probes exactly one slot, and compares the name once.
  */
 class Signature {
 public:
+  //! @brief The id and the arities of an action
+  struct Entry {
+    std::size_t id;
+    std::size_t stringSize;
+    std::size_t numberSize;
+  };
+
   Signature() = default;
   explicit Signature(std::istream &is) {
     std::string key;
@@ -24,46 +38,122 @@ public:
       if (is.fail()) {
         break;
       }
-      stringSizeMap[key] = stringSize;
-      numberSizeMap[key] = numberSize;
-      idMap[key] = id++;
+      insert(key, {id++, stringSize, numberSize});
+    }
+    buildTable();
+  }
+
+  /*!
+    @brief Find the id and the arities of the given action.
+    @returns The pointer to the entry of the action, or nullptr if the action is not defined.
+   */
+  [[nodiscard]] const Entry *find(std::string_view key) const {
+    if (table.empty()) {
+      return nullptr;
+    }
+    const std::uint32_t slot = table[hash(key, seed) & mask];
+    if (slot == 0 || names[slot - 1] != key) {
+      return nullptr;
     }
+    return &entries[slot - 1];
   }
-  [[nodiscard]] std::size_t getStringSize(const std::string &key) const {
-    return stringSizeMap.at(key);
+  [[nodiscard]] std::size_t getStringSize(std::string_view key) const {
+    return at(key).stringSize;
   }
-  [[nodiscard]] std::size_t getNumberSize(const std::string &key) const {
-    return numberSizeMap.at(key);
+  [[nodiscard]] std::size_t getNumberSize(std::string_view key) const {
+    return at(key).numberSize;
   }
-  [[nodiscard]] std::size_t getId(const std::string &key) const {
-    return idMap.at(key);
+  [[nodiscard]] std::size_t getId(std::string_view key) const {
+    return at(key).id;
   }
-  [[nodiscard]] bool isDefined(const std::string &key) const {
-    return idMap.find(key) != idMap.end();
+  [[nodiscard]] bool isDefined(std::string_view key) const {
+    return find(key) != nullptr;
   }
   [[nodiscard]] std::size_t size() const {
-    return this->idMap.size();
+    return this->names.size();
   }
   [[nodiscard]] std::vector<std::string> getKeys() const {
-    std::vector<std::string> keys;
-    keys.reserve(idMap.size());
-    for (const auto &[fst, snd]: idMap) {
-      keys.push_back(fst);
-    }
-    return keys;
+    return names;
   }
 
   Signature(std::unordered_map<std::string, std::size_t> idMap,
             std::unordered_map<std::string, std::size_t> stringSizeMap,
-            std::unordered_map<std::string, std::size_t> numberSizeMap)
-      : idMap(std::move(idMap)), stringSizeMap(std::move(stringSizeMap)), numberSizeMap(std::move(numberSizeMap)) {
+            std::unordered_map<std::string, std::size_t> numberSizeMap) {
     if (idMap.size() != stringSizeMap.size() || idMap.size() != numberSizeMap.size()) {
       throw std::runtime_error("Signature maps must have the same size");
     }
+    for (const auto &[key, id]: idMap) {
+      insert(key, {id, stringSizeMap.at(key), numberSizeMap.at(key)});
+    }
+    buildTable();
   }
 
 private:
-  std::unordered_map<std::string, std::size_t> idMap;
-  std::unordered_map<std::string, std::size_t> stringSizeMap;
-  std::unordered_map<std::string, std::size_t> numberSizeMap;
+  //! @brief The names of the actions. The entry of names[i] is entries[i].
+  std::vector<std::string> names;
+  std::vector<Entry> entries;
+  //! @brief The perfect hash table. Each slot is 0 if empty and the index in names plus 1 otherwise.
+  std::vector<std::uint32_t> table;
+  std::size_t mask = 0;
+  std::uint64_t seed = 0;
+
+  //! @brief Seeded FNV-1a hash
+  static std::uint64_t hash(std::string_view key, std::uint64_t seed) {
+    std::uint64_t h = 0xcbf29ce484222325ULL ^ (seed * 0x9e3779b97f4a7c15ULL);
+    for (const char c: key) {
+      h ^= static_cast<unsigned char>(c);
+      h *= 0x100000001b3ULL;
+    }
+    return h ^ (h >> 29);
+  }
+
+  const Entry &at(std::string_view key) const {
+    const Entry *entry = find(key);
+    if (!entry) {
+      throw std::out_of_range("Signature: undefined action " + std::string(key));
+    }
+    return *entry;
+  }
+
+  //! @brief Add or overwrite the entry of an action
+  void insert(const std::string &key, const Entry &entry) {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      if (names[i] == key) {
+        entries[i] = entry;
+        return;
+      }
+    }
+    names.push_back(key);
+    entries.push_back(entry);
+  }
+
+  /*!
+    @brief Search for a seed making the hash collision-free.
+
+    Since signatures are small, a table with at least twice as many slots as actions almost always has a
+    collision-free seed after a few trials. Otherwise, we double the table.
+   */
+  void buildTable() {
+    constexpr std::uint64_t maxTrials = 256;
+    std::size_t tableSize = 4;
+    while (tableSize < 2 * names.size()) {
+      tableSize *= 2;
+    }
+    while (true) {
+      mask = tableSize - 1;
+      for (seed = 0; seed < maxTrials; ++seed) {
+        table.assign(tableSize, 0);
+        bool collisionFree = true;
+        for (std::size_t i = 0; i < names.size() && collisionFree; ++i) {
+          std::uint32_t &slot = table[hash(names[i], seed) & mask];
+          collisionFree = slot == 0;
+          slot = static_cast<std::uint32_t>(i + 1);
+        }
+        if (collisionFree) {
+          return;
+        }
+      }
+      tableSize *= 2;
+    }
+  }
 };
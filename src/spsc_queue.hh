@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+  @brief A bounded single-producer single-consumer ring buffer
+
+  The producer fills the slot returned by back() and publishes it by push(). The consumer reads the contiguous
+  published slots returned by front() and releases them by pop(). The slots are never destroyed, so the storage of the
+  elements (e.g., the vectors in an event) is recycled.
+
+  Pushing and popping are lock-free. Only when the queue is full (backpressure) or empty, the waiting thread spins for
+  a while and then sleeps until the other thread makes progress.
+
+  @tparam T The element. It must be default constructible.
+ */
+template <typename T> class SpscQueue {
+public:
+  //! @param capacity The capacity is rounded up to a power of two.
+  explicit SpscQueue(std::size_t capacity) {
+    std::size_t size = 1;
+    while (size < capacity) {
+      size *= 2;
+    }
+    slots.resize(size);
+    mask = size - 1;
+  }
+
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  [[nodiscard]] std::size_t capacity() const {
+    return slots.size();
+  }
+
+  //! @brief Returns the next free slot, waiting while the queue is full. Only the producer calls it.
+  T &back() {
+    const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+    wait([&] { return tail - head.load(std::memory_order_seq_cst) < slots.size(); });
+    return slots[tail & mask];
+  }
+
+  //! @brief Publish the slot returned by back(). Only the producer calls it.
+  void push() {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+    wake();
+  }
+
+  //! @brief Tell the consumer that nothing is pushed any more. Only the producer calls it.
+  void close() {
+    closed.store(true, std::memory_order_seq_cst);
+    wake();
+  }
+
+  /*!
+    @brief Wait for a published slot, and get the contiguous published slots. Only the consumer calls it.
+
+    @param data The first published slot
+    @returns The number of the contiguous published slots from data. It is 0 if and only if the queue is closed and
+    empty.
+   */
+  std::size_t front(T *&data) {
+    const std::size_t head = this->head.load(std::memory_order_relaxed);
+    std::size_t tail;
+    wait([&] {
+      // We read closed before tail so that we do not miss the slots pushed just before close().
+      const bool isClosed = closed.load(std::memory_order_seq_cst);
+      tail = this->tail.load(std::memory_order_seq_cst);
+      return tail != head || isClosed;
+    });
+    data = &slots[head & mask];
+    return std::min(tail - head, slots.size() - (head & mask));
+  }
+
+  //! @brief Release the given number of slots from the front. Only the consumer calls it.
+  void pop(std::size_t count) {
+    head.store(head.load(std::memory_order_relaxed) + count, std::memory_order_seq_cst);
+    wake();
+  }
+
+private:
+  //! @brief The number of the trials before a waiting thread sleeps
+  static constexpr int spinCount = 64;
+  std::vector<T> slots;
+  std::size_t mask;
+  //! @brief The slot i is published if head <= i < tail. The counters never wrap around in practice.
+  alignas(64) std::atomic<std::size_t> head{0};
+  alignas(64) std::atomic<std::size_t> tail{0};
+  std::atomic<bool> closed{false};
+  //! @brief The number of the threads sleeping in wait(). We notify only if it is positive.
+  std::atomic<int> sleepers{0};
+  std::mutex mutex;
+  std::condition_variable progress;
+
+  template <typename Ready> void wait(const Ready &ready) {
+    for (int i = 0; i < spinCount; ++i) {
+      if (ready()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    // The counter is incremented before we check the condition again. Therefore, either we see the progress, or the
+    // other thread sees the sleeper and notifies us after we start waiting.
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    progress.wait(lock, ready);
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void wake() {
+    if (sleepers.load(std::memory_order_seq_cst) > 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      progress.notify_all();
+    }
+  }
+};
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/*!
+  @brief The pool of the strings appearing in the specification and the timed word.
+
+  Each distinct string is stored exactly once and identified by a 32-bit id. The id 0 is the empty string.
+
+  @note The strings are never released, and the pool is not bounded by MonitorBudget. Since the storage consists of chunks of geometrically increasing size that are
+  never moved, the references returned by str() are valid until the program terminates.
+  @note intern() is not thread-safe, and only one thread, i.e., the parser, may intern strings while monitoring. Other
+  threads may call str() for the ids they have received because the strings are never moved.
+ */
+class StringPool {
+public:
+  using id_type = std::uint32_t;
+
+  //! @brief The pool shared by the entire program
+  static StringPool &global() {
+    static StringPool pool;
+    return pool;
+  }
+
+  //! @brief Returns the id of the given string, adding it to the pool if it is new.
+  id_type intern(std::string_view str) {
+    if (const auto it = ids.find(str); it != ids.end()) {
+      return it->second;
+    }
+    if (count == std::numeric_limits<id_type>::max()) {
+      throw std::runtime_error("StringPool: too many distinct strings");
+    }
+    const auto id = static_cast<id_type>(count++);
+    const auto [chunk, offset] = locate(id);
+    if (!chunks[chunk]) {
+      chunks[chunk] = std::make_unique<std::string[]>(firstChunkSize << chunk);
+      bytes += sizeof(std::string) * (firstChunkSize << chunk);
+    }
+    std::string &stored = chunks[chunk][offset];
+    stored.assign(str.data(), str.size());
+    ids.emplace(stored, id);
+    // The heap buffer of the string and the node and the bucket of the index
+    bytes += str.size() + 1 + sizeof(std::pair<const std::string_view, id_type>) + 2 * sizeof(void *);
+    return id;
+  }
+
+  //! @brief Returns the string of the given id.
+  [[nodiscard]] const std::string &str(id_type id) const {
+    const auto [chunk, offset] = locate(id);
+    return chunks[chunk][offset];
+  }
+
+  //! @brief Returns the number of the interned strings.
+  [[nodiscard]] std::size_t size() const {
+    return count;
+  }
+
+  //! @brief Returns the approximate memory of the pool in bytes.
+  [[nodiscard]] std::size_t memoryInBytes() const {
+    return bytes;
+  }
+
+private:
+  static constexpr std::size_t firstChunkBits = 10;
+  static constexpr std::size_t firstChunkSize = std::size_t{1} << firstChunkBits;
+  //! @brief The chunk i contains firstChunkSize * 2^i strings. 23 chunks cover all the 32-bit ids.
+  std::array<std::unique_ptr<std::string[]>, 23> chunks;
+  std::size_t count = 0;
+  std::size_t bytes = 0;
+  std::unordered_map<std::string_view, id_type> ids;
+
+  StringPool() {
+    intern("");
+  }
+
+  //! @brief Returns the chunk and the offset of the given id.
+  static std::pair<std::size_t, std::size_t> locate(id_type id) {
+    const unsigned long long shifted = std::size_t{id} + firstChunkSize;
+    const std::size_t chunk = 63 - __builtin_clzll(shifted) - firstChunkBits;
+    return {chunk, shifted - (firstChunkSize << chunk)};
+  }
+};
+
+/*!
+  @brief A string interned in StringPool::global().
+
+  Copying, hashing, and comparing for equality are integer operations on the id.
+
+  @note The order by operator< is the order of the ids, i.e., the order of interning, not the lexicographic order.
+ */
+class InternedString {
+public:
+  //! @brief The empty string
+  InternedString() = default;
+  InternedString(std::string_view str) : stringId(StringPool::global().intern(str)) {
+  }
+  InternedString(const std::string &str) : InternedString(std::string_view(str)) {
+  }
+  InternedString(const char *str) : InternedString(std::string_view(str)) {
+  }
+
+  [[nodiscard]] StringPool::id_type id() const {
+    return stringId;
+  }
+  [[nodiscard]] const std::string &str() const {
+    return StringPool::global().str(stringId);
+  }
+  [[nodiscard]] const char *c_str() const {
+    return str().c_str();
+  }
+
+  friend bool operator==(InternedString lhs, InternedString rhs) {
+    return lhs.stringId == rhs.stringId;
+  }
+  friend bool operator!=(InternedString lhs, InternedString rhs) {
+    return lhs.stringId != rhs.stringId;
+  }
+  friend bool operator<(InternedString lhs, InternedString rhs) {
+    return lhs.stringId < rhs.stringId;
+  }
+  friend std::size_t hash_value(InternedString str) {
+    return str.stringId;
+  }
+  friend std::ostream &operator<<(std::ostream &os, InternedString str) {
+    return os << str.str();
+  }
+
+private:
+  StringPool::id_type stringId = 0;
+};
+
+template <> struct std::hash<InternedString> {
+  std::size_t operator()(InternedString str) const {
+    return str.id();
+  }
+};
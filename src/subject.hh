@@ -39,6 +39,11 @@ protected:
       observer->notify(data);
     }
   }
+  void notifyObserversBatch(const T *data, std::size_t size) const {
+    if (observer && size > 0) {
+      observer->notifyBatch(data, size);
+    }
+  }
   std::shared_ptr<Observer<T>> observer;
 };
 
@@ -66,5 +71,12 @@ protected:
       }
     }
   };
+  void notifyObserversBatch(const T *data, std::size_t size) const {
+    for (const auto observer: ptrs) {
+      if (observer && size > 0) {
+        observer->notifyBatch(data, size);
+      }
+    }
+  }
   std::vector<std::shared_ptr<Observer<T>>> ptrs;
 };
@@ -0,0 +1,454 @@
+#pragma once
+
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "guard_memo.hh"
+#include "ppl_rational.hh"
+#include "symbolic_number_constraint.hh"
+#include "symbolic_string_constraint.hh"
+#include "symbolic_update.hh"
+
+namespace Symbolic {
+  //! @brief The number valuations by the products of intervals
+  using BoxNumberValuation = Parma_Polyhedra_Library::Rational_Box;
+  //! @brief The number valuations by octagons, i.e., the conjunctions of the bounds of +-x +-y
+  using OctagonNumberValuation = Parma_Polyhedra_Library::Octagonal_Shape<mpq_class>;
+
+  /*!
+    @brief The operations of DataParametricMonitor on the number valuations in a numerical domain of PPL
+
+    A valuation has one dimension for each number variable. The data of the current event are substituted into the
+    number guards and the number updates, so the valuation needs no dimensions for them. Since the data are concrete,
+    the substituted guards and updates are often within the domain even if they relate a variable with the data.
+
+    @tparam Valuation BoxNumberValuation or OctagonNumberValuation. The polyhedra (NumberValuation) are handled by the
+    specialization below.
+   */
+  template <typename Valuation> class NumberDomain {
+  public:
+    static constexpr bool isBox = std::is_same_v<Valuation, BoxNumberValuation>;
+    //! @brief Each configuration has its own valuation, so the configurations can be expanded in parallel.
+    static constexpr bool isThreadSafe = true;
+
+    //! @note The capacity of the guard memo is ignored because nothing is memoized.
+    explicit NumberDomain(std::size_t numberVariableSize, std::size_t = 0) : numberVariableSize(numberVariableSize) {
+    }
+
+    /*!
+      @brief Returns if the domain represents the results of the number guard and the number update exactly.
+
+      A box is exact if each constraint refers to at most one number variable, and each update of x refers to no number
+      variable other than x. An octagon is exact if each constraint is a non-strict bound of x, of x + y, or of x - y
+      (up to a positive factor), and each update of x is x := e or x := +-y + e, where e refers only to the data.
+     */
+    bool isExact(const std::vector<NumberConstraint> &constraints, const Update &update) const {
+      for (const NumberConstraint &constraint: constraints) {
+        const auto coefficients = variableCoefficients(constraint);
+        if (isBox ? coefficients.size() > 1
+                  : constraint.is_strict_inequality() || coefficients.size() > 2 ||
+                        (coefficients.size() == 2 && coefficients[0].second != coefficients[1].second &&
+                         coefficients[0].second != -coefficients[1].second)) {
+          return false;
+        }
+      }
+      for (const auto &[to, from]: update.numberUpdate) {
+        const auto coefficients = variableCoefficients(from);
+        if (coefficients.empty()) {
+          continue;
+        }
+        if (coefficients.size() > 1 ||
+            (isBox ? coefficients[0].first != to
+                   : coefficients[0].second != 1 && coefficients[0].second != -1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    //! @brief Start a new event. This does nothing because nothing is memoized.
+    void beginEvent() const {
+    }
+
+    //! @brief Returns zero counters because nothing is memoized.
+    [[nodiscard]] GuardMemoCounters guardMemoCounters() const {
+      return {};
+    }
+
+    //! @brief Prepare the valuation for the current event. This does nothing because the data are substituted.
+    void embed(Valuation &, const std::vector<PPLRational> &) const {
+    }
+
+    //! @brief Evaluate the guard with the data of the current event, and returns false if it does not hold.
+    bool eval(const std::vector<StringConstraint> &stringConstraints, StringValuation &stringEnv,
+              const std::vector<NumberConstraint> &numConstraints, Valuation &numEnv,
+              const std::vector<PPLRational> &numbers) const {
+      if (!std::all_of(stringConstraints.begin(), stringConstraints.end(),
+                       [&stringEnv](const StringConstraint &constraint) { return constraint.eval(stringEnv); })) {
+        return false;
+      }
+      for (const NumberConstraint &constraint: numConstraints) {
+        Parma_Polyhedra_Library::Coefficient denominator;
+        const auto expr = instantiate(constraint, numbers, denominator);
+        // This is exact if the constraint is within the domain, and an over-approximation otherwise.
+        switch (constraint.type()) {
+          case NumberConstraint::EQUALITY:
+            numEnv.refine_with_constraint(expr == 0);
+            break;
+          case NumberConstraint::NONSTRICT_INEQUALITY:
+            numEnv.refine_with_constraint(expr >= 0);
+            break;
+          case NumberConstraint::STRICT_INEQUALITY:
+            numEnv.refine_with_constraint(expr > 0);
+            break;
+        }
+      }
+      return !numEnv.is_empty();
+    }
+
+    //! @brief Apply the update with the data of the current event.
+    void execute(const Update &update, StringValuation &stringEnv, Valuation &numEnv,
+                 const std::vector<PPLRational> &numbers) const {
+      update.executeString(stringEnv);
+      for (const auto &[to, from]: update.numberUpdate) {
+        Parma_Polyhedra_Library::Coefficient denominator;
+        const auto expr = instantiate(from, numbers, denominator);
+        numEnv.affine_image(Parma_Polyhedra_Library::Variable(to), expr, denominator);
+      }
+    }
+
+    //! @brief Remove the dimensions for the data. This does nothing because there are no such dimensions.
+    void project(Valuation &) const {
+    }
+
+    [[nodiscard]] NumberValuation toPolyhedron(const Valuation &numEnv) const {
+      return NumberValuation(numEnv);
+    }
+
+  private:
+    std::size_t numberVariableSize;
+
+    //! @brief Returns the pairs of the number variables in the row and their coefficients.
+    template <typename Row>
+    std::vector<std::pair<VariableID, Parma_Polyhedra_Library::Coefficient>>
+    variableCoefficients(const Row &row) const {
+      std::vector<std::pair<VariableID, Parma_Polyhedra_Library::Coefficient>> result;
+      for (std::size_t i = 0; i < std::min(numberVariableSize, row.space_dimension()); ++i) {
+        const Parma_Polyhedra_Library::Coefficient c = row.coefficient(Parma_Polyhedra_Library::Variable(i));
+        if (c != 0) {
+          result.emplace_back(i, c);
+        }
+      }
+      return result;
+    }
+
+    /*!
+      @brief Substitute the data into the linear expression or the left-hand side of the constraint.
+
+      @param denominator The denominator to divide the result by, which is the product of the denominators of the data
+      @returns The numerator, which refers only to the number variables
+     */
+    template <typename Row>
+    Parma_Polyhedra_Library::Linear_Expression instantiate(const Row &row, const std::vector<PPLRational> &numbers,
+                                                           Parma_Polyhedra_Library::Coefficient &denominator) const {
+      using Parma_Polyhedra_Library::Variable;
+      denominator = 1;
+      for (std::size_t i = numberVariableSize; i < row.space_dimension(); ++i) {
+        if (row.coefficient(Variable(i)) != 0) {
+          denominator *= numbers.at(i - numberVariableSize).getDenominator();
+        }
+      }
+      Parma_Polyhedra_Library::Coefficient inhomogeneous = row.inhomogeneous_term() * denominator;
+      Parma_Polyhedra_Library::Linear_Expression result;
+      for (std::size_t i = 0; i < row.space_dimension(); ++i) {
+        const Parma_Polyhedra_Library::Coefficient c = row.coefficient(Variable(i));
+        if (c == 0) {
+          continue;
+        }
+        if (i < numberVariableSize) {
+          result += Variable(i) * (c * denominator);
+        } else {
+          const PPLRational &data = numbers[i - numberVariableSize];
+          inhomogeneous += c * data.getNumerator() * (denominator / data.getDenominator());
+        }
+      }
+      result += inhomogeneous;
+      return result;
+    }
+  };
+
+  /*!
+    @brief The operations of DataParametricMonitor on the number valuations by NNC_Polyhedron
+
+    The valuation is extended with a dimension for each datum of the current event, which is exact for any linear guard
+    and update.
+   */
+  template <> class NumberDomain<NumberValuation> {
+  public:
+    static constexpr bool isThreadSafe = true;
+
+    //! @note The capacity of the guard memo is ignored because nothing is memoized.
+    explicit NumberDomain(std::size_t numberVariableSize, std::size_t = 0) : numberVariableSize(numberVariableSize) {
+    }
+
+    bool isExact(const std::vector<NumberConstraint> &, const Update &) const {
+      return true;
+    }
+
+    void beginEvent() const {
+    }
+
+    //! @brief Returns zero counters because the results of the guards are not memoized.
+    [[nodiscard]] GuardMemoCounters guardMemoCounters() const {
+      return {};
+    }
+
+    //! @brief Add the dimensions for the data of the current event.
+    void embed(NumberValuation &numEnv, const std::vector<PPLRational> &numbers) const {
+      assert(numEnv.space_dimension() == numberVariableSize);
+      numEnv.add_space_dimensions_and_embed(numbers.size());
+      for (std::size_t i = 0; i < numbers.size(); i++) {
+        numEnv.add_constraint(Parma_Polyhedra_Library::Variable(numberVariableSize + i) *
+                                  numbers[i].getDenominator() ==
+                              numbers[i].getNumerator());
+      }
+    }
+
+    bool eval(const std::vector<StringConstraint> &stringConstraints, StringValuation &stringEnv,
+              const std::vector<NumberConstraint> &numConstraints, NumberValuation &numEnv,
+              const std::vector<PPLRational> &) const {
+      return Symbolic::eval(stringConstraints, stringEnv, numConstraints, numEnv);
+    }
+
+    void execute(const Update &update, StringValuation &stringEnv, NumberValuation &numEnv,
+                 const std::vector<PPLRational> &) const {
+      update.execute(stringEnv, numEnv);
+    }
+
+    //! @brief Remove the dimensions for the data.
+    void project(NumberValuation &numEnv) const {
+      numEnv.remove_higher_space_dimensions(numberVariableSize);
+    }
+
+    [[nodiscard]] const NumberValuation &toPolyhedron(const NumberValuation &numEnv) const {
+      return numEnv;
+    }
+
+  private:
+    std::size_t numberVariableSize;
+  };
+
+  /*!
+    @brief A polyhedron of the number variables shared by the copies until it is modified
+
+    It is immutable and reference counted, so copying a configuration copies only a pointer. The configurations taking
+    the same transition from a shared valuation also share the result, which NumberDomain<SharedNumberValuation>
+    memoizes.
+
+    @note PPL may update the internal representation of a polyhedron even in a const operation, so the valuations
+    sharing a polyhedron must be used by one thread.
+    @note A default constructed valuation has no polyhedron. It must be assigned before use.
+   */
+  class SharedNumberValuation {
+  public:
+    SharedNumberValuation() = default;
+
+    //! @brief The universe of the dimension
+    explicit SharedNumberValuation(std::size_t dimension) : SharedNumberValuation(NumberValuation(dimension)) {
+    }
+
+    explicit SharedNumberValuation(NumberValuation polyhedron)
+        : polyhedron(std::make_shared<const NumberValuation>(std::move(polyhedron))) {
+    }
+
+    [[nodiscard]] const NumberValuation &get() const {
+      return *polyhedron;
+    }
+
+    //! @brief Returns the address of the shared polyhedron, which identifies it while it is alive.
+    [[nodiscard]] const void *identity() const {
+      return polyhedron.get();
+    }
+
+    [[nodiscard]] bool contains(const SharedNumberValuation &other) const {
+      return polyhedron == other.polyhedron || polyhedron->contains(*other.polyhedron);
+    }
+
+    void upper_bound_assign(const SharedNumberValuation &other) {
+      if (contains(other)) {
+        return;
+      }
+      NumberValuation hull = *polyhedron;
+      hull.upper_bound_assign(*other.polyhedron);
+      *this = SharedNumberValuation(std::move(hull));
+    }
+
+    //! @brief Returns the heap memory of the polyhedron divided by the number of the valuations sharing it.
+    [[nodiscard]] std::size_t external_memory_in_bytes() const {
+      return (sizeof(NumberValuation) + polyhedron->external_memory_in_bytes()) / polyhedron.use_count();
+    }
+
+    bool operator==(const SharedNumberValuation &other) const {
+      return polyhedron == other.polyhedron || *polyhedron == *other.polyhedron;
+    }
+    bool operator!=(const SharedNumberValuation &other) const {
+      return !(*this == other);
+    }
+
+    //! @note Like NNC_Polyhedron::hash_code(), the hash only depends on the dimension.
+    friend std::size_t hash_value(const SharedNumberValuation &valuation) {
+      return valuation.polyhedron->hash_code();
+    }
+
+  private:
+    std::shared_ptr<const NumberValuation> polyhedron;
+  };
+
+  /*!
+    @brief The operations of DataParametricMonitor on SharedNumberValuation
+
+    The operations are those of NumberDomain<NumberValuation>, and their results are memoized for each pair of the
+    shared polyhedron and the guard, the update, or the projection. The data are fixed within an event, so the results
+    are forgotten at the beginning of each event. The data are embedded when a guard is evaluated, so the shared
+    results of the guards are shared by the updates too.
+
+    @note The memo is not synchronized, so this domain must be used by one thread.
+   */
+  template <> class NumberDomain<SharedNumberValuation> {
+  public:
+    static constexpr bool isThreadSafe = false;
+
+    //! @param guardMemoCapacity The maximum number of the results of the guards memoized across the events, or zero
+    //! for no memo
+    explicit NumberDomain(std::size_t numberVariableSize, std::size_t guardMemoCapacity = 0)
+        : numberVariableSize(numberVariableSize), polyhedra(numberVariableSize), guardMemo(guardMemoCapacity) {
+    }
+
+    bool isExact(const std::vector<NumberConstraint> &, const Update &) const {
+      return true;
+    }
+
+    //! @brief Forget the memoized results, which depend on the data of the previous event.
+    void beginEvent() const {
+      memo.clear();
+    }
+
+    //! @brief This does nothing. The data are embedded by eval() only when its result is not memoized.
+    void embed(SharedNumberValuation &, const std::vector<PPLRational> &) const {
+    }
+
+    bool eval(const std::vector<StringConstraint> &stringConstraints, StringValuation &stringEnv,
+              const std::vector<NumberConstraint> &numConstraints, SharedNumberValuation &numEnv,
+              const std::vector<PPLRational> &numbers) const {
+      if (!std::all_of(stringConstraints.begin(), stringConstraints.end(),
+                       [&stringEnv](const StringConstraint &constraint) { return constraint.eval(stringEnv); })) {
+        return false;
+      }
+      return apply(numEnv, &numConstraints, [&](NumberValuation &polyhedron) {
+        polyhedra.embed(polyhedron, numbers);
+        return guardMemo.apply(polyhedron, &numConstraints, [&numConstraints](NumberValuation &embedded) {
+          return evalUpdate(numConstraints, embedded);
+        });
+      });
+    }
+
+    void execute(const Update &update, StringValuation &stringEnv, SharedNumberValuation &numEnv,
+                 const std::vector<PPLRational> &) const {
+      update.executeString(stringEnv);
+      if (update.numberUpdate.empty()) {
+        return;
+      }
+      apply(numEnv, &update, [&update](NumberValuation &polyhedron) {
+        for (const auto &[to, from]: update.numberUpdate) {
+          polyhedron.affine_image(Parma_Polyhedra_Library::Variable(to), from);
+        }
+        return true;
+      });
+    }
+
+    void project(SharedNumberValuation &numEnv) const {
+      if (numEnv.get().space_dimension() == numberVariableSize) {
+        return;
+      }
+      apply(numEnv, this, [this](NumberValuation &polyhedron) {
+        polyhedra.project(polyhedron);
+        return true;
+      });
+    }
+
+    [[nodiscard]] const NumberValuation &toPolyhedron(const SharedNumberValuation &numEnv) const {
+      return numEnv.get();
+    }
+
+    //! @brief Returns the numbers of the guards whose results are memoized across the events and computed.
+    [[nodiscard]] GuardMemoCounters guardMemoCounters() const {
+      return guardMemo.getCounters();
+    }
+
+  private:
+    //! @brief The identity of the source and the address of the operation
+    using MemoKey = std::pair<const void *, const void *>;
+    //! @brief A memoized result. It holds the source so that its identity is not reused while the result is memoized.
+    struct Memo {
+      SharedNumberValuation source;
+      //! @brief The result, or std::nullopt if it is empty
+      std::optional<SharedNumberValuation> result;
+    };
+
+    std::size_t numberVariableSize;
+    NumberDomain<NumberValuation> polyhedra;
+    mutable std::unordered_map<MemoKey, Memo, boost::hash<MemoKey>> memo;
+    /*!
+      @brief The results of the number guards on the polyhedra with the data embedded, keyed by the address of the guard
+
+      Unlike memo, this is kept across the events, so it is used when the same polyhedron and data recur.
+     */
+    mutable GuardMemo<NumberValuation, const void *> guardMemo;
+
+    /*!
+      @brief Replace the valuation with the memoized result of the operation, or compute it by a copy of the polyhedron.
+
+      @param operation The address identifying the operation within the current event
+      @param compute A function applying the operation to a polyhedron and returning false if the result is empty
+      @returns false if the result is empty
+     */
+    template <typename Compute>
+    bool apply(SharedNumberValuation &numEnv, const void *operation, const Compute &compute) const {
+      const auto key = std::make_pair(numEnv.identity(), operation);
+      if (const auto it = memo.find(key); it != memo.end()) {
+        if (!it->second.result) {
+          return false;
+        }
+        numEnv = *it->second.result;
+        return true;
+      }
+      NumberValuation polyhedron = numEnv.get();
+      Memo &entry = memo[key];
+      entry.source = numEnv;
+      if (!compute(polyhedron)) {
+        return false;
+      }
+      entry.result = SharedNumberValuation(std::move(polyhedron));
+      numEnv = *entry.result;
+      return true;
+    }
+  };
+} // namespace Symbolic
+
+namespace Parma_Polyhedra_Library {
+  //! @note Like NNC_Polyhedron::hash_code(), the hash only depends on the dimension.
+  template <typename ITV> std::size_t hash_value(const Box<ITV> &box) {
+    return box.space_dimension();
+  }
+
+  template <typename T> std::size_t hash_value(const Octagonal_Shape<T> &octagon) {
+    return octagon.space_dimension();
+  }
+} // namespace Parma_Polyhedra_Library
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "common_types.hh"
+#include "string_pool.hh"
 
 template <typename T> void insert_sorted(std::vector<T> &vec, const T &value) {
   auto it = std::lower_bound(vec.begin(), vec.end(), value);
@@ -17,14 +18,14 @@ template <typename T> void insert_sorted(std::vector<T> &vec, const T &value) {
 }
 
 namespace Symbolic {
-  using StringValuation = std::vector<std::variant<std::vector<std::string>, std::string>>;
+  using StringValuation = std::vector<std::variant<std::vector<InternedString>, InternedString>>;
 
   struct StringAtom {
-    std::variant<VariableID, std::string> value;
+    std::variant<VariableID, InternedString> value;
 
-    void eval(const StringValuation &env, std::variant<std::vector<std::string>, std::string> &result) const {
+    void eval(const StringValuation &env, std::variant<std::vector<InternedString>, InternedString> &result) const {
       if (value.index() == 1) {
-        result = std::get<std::string>(value);
+        result = std::get<InternedString>(value);
       } else {
         result = env.at(std::get<std::size_t>(value));
       }
@@ -41,7 +42,7 @@ namespace Symbolic {
     enum class kind_t { EQ, NE } kind;
 
     bool eval(StringValuation &env) const {
-      std::array<std::variant<std::vector<std::string>, std::string>, 2> evaluated;
+      std::array<std::variant<std::vector<InternedString>, InternedString>, 2> evaluated;
       for (int i = 0; i < 2; i++) {
         children[i].eval(env, evaluated[i]);
       }
@@ -52,14 +53,14 @@ namespace Symbolic {
                   "StringConstraint";
           } else if (evaluated[0].index() == 0 && evaluated[1].index() == 1) {
             const VariableID assignedID = std::get<VariableID>(children[0].value);
-            const std::string &assignedString = std::get<std::string>(evaluated[1]);
+            const InternedString assignedString = std::get<InternedString>(evaluated[1]);
             return assignIfPossible(env, assignedID, assignedString);
           } else if (evaluated[0].index() == 1 && evaluated[1].index() == 0) {
             const VariableID assignedID = std::get<VariableID>(children[1].value);
-            const std::string &assignedString = std::get<std::string>(evaluated[0]);
+            const InternedString assignedString = std::get<InternedString>(evaluated[0]);
             return assignIfPossible(env, assignedID, assignedString);
           } else {
-            return std::get<std::string>(evaluated[0]) == std::get<std::string>(evaluated[1]);
+            return std::get<InternedString>(evaluated[0]) == std::get<InternedString>(evaluated[1]);
           }
           break;
         }
@@ -68,15 +69,15 @@ namespace Symbolic {
             throw "Unimplemented case: At least one of the children must have a concrete value. "
                   "StringConstraint";
           } else if (evaluated[0].index() == 0 && evaluated[1].index() == 1) {
-            const std::string &disabledString = std::get<std::string>(evaluated[1]);
+            const InternedString disabledString = std::get<InternedString>(evaluated[1]);
             insert_sorted(std::get<0>(env[std::get<VariableID>(children[0].value)]), disabledString);
             return true;
           } else if (evaluated[0].index() == 1 && evaluated[1].index() == 0) {
-            const std::string &disabledString = std::get<std::string>(evaluated[0]);
+            const InternedString disabledString = std::get<InternedString>(evaluated[0]);
             insert_sorted(std::get<0>(env[std::get<VariableID>(children[1].value)]), disabledString);
             return true;
           } else {
-            return std::get<std::string>(evaluated[0]) != std::get<std::string>(evaluated[1]);
+            return std::get<InternedString>(evaluated[0]) != std::get<InternedString>(evaluated[1]);
           }
         }
       }
@@ -84,8 +85,8 @@ namespace Symbolic {
     }
 
   private:
-    bool assignIfPossible(StringValuation &env, const VariableID assignedID, const std::string &assignedString) const {
-      std::vector<std::string> &disabledStrings = std::get<0>(env[assignedID]);
+    bool assignIfPossible(StringValuation &env, const VariableID assignedID, const InternedString assignedString) const {
+      std::vector<InternedString> &disabledStrings = std::get<0>(env[assignedID]);
       if (!std::binary_search(disabledStrings.begin(), disabledStrings.end(), assignedString)) {
         // assignedString is not disabled
         env[assignedID] = assignedString;
@@ -102,7 +103,7 @@ namespace Symbolic {
     explicit SCMaker(VariableID id) : first({id}) {
     }
 
-    StringConstraint operator==(const std::string &str) {
+    StringConstraint operator==(const InternedString str) {
       const StringAtom second{str};
       return {{first, second}, StringConstraint::kind_t::EQ};
     }
@@ -112,7 +113,7 @@ namespace Symbolic {
       return {{first, second}, StringConstraint::kind_t::EQ};
     }
 
-    StringConstraint operator!=(const std::string &str) {
+    StringConstraint operator!=(const InternedString str) {
       const StringAtom second{str};
       return {{first, second}, StringConstraint::kind_t::NE};
     }
@@ -14,13 +14,7 @@ namespace Symbolic {
     std::vector<std::pair<VariableID, Symbolic::NumberExpression>> numberUpdate;
 
     void execute(Symbolic::StringValuation &stringEnv, Symbolic::NumberValuation &numEnv) const {
-      for (const auto &update: stringUpdate) {
-        const auto from = update.second;
-        const auto to = update.first;
-        std::variant<std::vector<std::string>, std::string> result;
-        from.eval(stringEnv, result);
-        stringEnv[to] = result;
-      }
+      executeString(stringEnv);
       for (const auto &update: numberUpdate) {
         const auto from = update.second;
         const auto to = update.first;
@@ -31,6 +25,17 @@ namespace Symbolic {
         // numEnv.add_constraint(constraint);
       }
     }
+
+    //! @brief Apply only the string updates. The number updates are applied by the number domain of the monitor.
+    void executeString(Symbolic::StringValuation &stringEnv) const {
+      for (const auto &update: stringUpdate) {
+        const auto from = update.second;
+        const auto to = update.first;
+        std::variant<std::vector<InternedString>, InternedString> result;
+        from.eval(stringEnv, result);
+        stringEnv[to] = result;
+      }
+    }
   };
 
   static inline bool evalUpdate(const std::vector<Symbolic::NumberConstraint> &numConstraints,
@@ -0,0 +1,58 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "binary_result.hh"
+#include "printer.hh"
+
+/*!
+  @brief Read the results in the binary format and print them as the text
+
+  @param printer The text printer of the kind of the results
+ */
+template <typename Printer> static void convert(BinaryResult::Reader &reader, Printer &&printer) {
+  BinaryResult::Record record;
+  while (reader.next(record)) {
+    printer.printRecord(record);
+  }
+}
+
+//! @brief Convert the results printed by `symon --output-format binary` to the text printed by default.
+int main(int argc, char *argv[]) {
+  std::ios::sync_with_stdio(false);
+  const std::string fileName = argc > 1 ? argv[1] : "-";
+  if (argc > 2 || fileName == "-h" || fileName == "--help") {
+    std::cout << "symon_convert [RESULT_FILE]\n"
+              << "Convert the results of symon --output-format binary in RESULT_FILE (default: standard input) to the "
+                 "text.\n";
+    return argc > 2;
+  }
+  std::ifstream file;
+  if (fileName != "-") {
+    file.open(fileName, std::ios::binary);
+    if (file.fail()) {
+      std::cerr << "Error: " << strerror(errno) << " " << fileName << std::endl;
+      return 1;
+    }
+  }
+
+  try {
+    BinaryResult::Reader reader(fileName == "-" ? std::cin : file);
+    switch (reader.kind()) {
+      case BinaryResult::Kind::Boolean:
+        convert(reader, BooleanPrinter<double>());
+        break;
+      case BinaryResult::Kind::DataParametric:
+        convert(reader, DataParametricPrinter());
+        break;
+      case BinaryResult::Kind::Parametric:
+        convert(reader, ParametricPrinter());
+        break;
+    }
+  } catch (const std::runtime_error &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*!
+  @brief A fixed set of worker threads running the tasks of parallelFor with work stealing
+
+  The thread calling parallelFor also runs tasks, so a pool of size N has N - 1 workers. Each thread is identified by
+  its slot: the calling thread is the slot 0, and the workers are the slots 1, ..., N - 1.
+
+  The indices of the tasks are split into one contiguous range per thread. Each thread takes the tasks from the front
+  of its own range, and when it runs out, it steals the back half of the range of another thread. Therefore, the load
+  is balanced even if the cost of the tasks varies a lot, e.g., the polyhedral operations of the configurations.
+
+  A library with per-thread state can be initialized in each worker by makeWorkerContext. For example, PPL requires a
+  Parma_Polyhedra_Library::Thread_Init object in each thread other than the main thread.
+ */
+class ThreadPool {
+public:
+  /*!
+    @param size The number of the threads including the calling thread
+    @param makeWorkerContext If given, it is called at the start of each worker, and the returned object is kept
+    until the worker stops.
+   */
+  explicit ThreadPool(std::size_t size, std::function<std::shared_ptr<void>()> makeWorkerContext = nullptr)
+      : ranges(std::make_unique<Range[]>(std::max<std::size_t>(size, 1))) {
+    for (std::size_t slot = 1; slot < size; ++slot) {
+      workers.emplace_back([this, slot, makeWorkerContext] {
+        const auto workerContext = makeWorkerContext ? makeWorkerContext() : nullptr;
+        work(slot);
+      });
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto &worker: workers) {
+      worker.join();
+    }
+  }
+
+  //! @brief The number of the threads including the calling thread
+  [[nodiscard]] std::size_t size() const {
+    return workers.size() + 1;
+  }
+
+  /*!
+    @brief Run task(i) or task(i, slot) for each i in [0, n) and wait for all of them.
+
+    The tasks may run in any order. The slot is the thread running the task, which can index per-thread data.
+
+    @throws Rethrows the exception thrown by a task, if any. The tasks not started yet are skipped.
+   */
+  template <typename Task> void parallelFor(std::size_t n, Task &&task) {
+    if (n > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::length_error("ThreadPool: too many tasks");
+    }
+    if (workers.empty() || n <= 1) {
+      for (std::size_t i = 0; i < n; ++i) {
+        invokeTask(task, i, 0);
+      }
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      taskContext = &task;
+      invoke = [](void *context, std::size_t i, std::size_t slot) {
+        invokeTask(*static_cast<std::remove_reference_t<Task> *>(context), i, slot);
+      };
+      for (std::size_t slot = 0; slot < size(); ++slot) {
+        ranges[slot].bounds = pack(n * slot / size(), n * (slot + 1) / size());
+      }
+      cancelled = false;
+      pending = workers.size();
+      error = nullptr;
+      ++generation;
+    }
+    wakeUp.notify_all();
+    runTasks(0);
+    std::unique_lock<std::mutex> lock(mutex);
+    // Wait for all the workers, so that no worker refers to this task after we return.
+    finished.wait(lock, [this] { return pending == 0; });
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  //! @brief The unclaimed tasks [begin, end) of a thread, packed as begin << 32 | end
+  struct alignas(64) Range {
+    std::atomic<std::uint64_t> bounds{0};
+  };
+
+  std::vector<std::thread> workers;
+  std::unique_ptr<Range[]> ranges;
+  std::mutex mutex;
+  std::condition_variable wakeUp, finished;
+  //! @brief The current task. It is type-erased without any allocation.
+  void *taskContext = nullptr;
+  void (*invoke)(void *, std::size_t, std::size_t) = nullptr;
+  //! @brief If true, the remaining tasks are skipped because a task threw an exception.
+  std::atomic<bool> cancelled{false};
+  //! @brief The number of the workers that have not finished the current generation
+  std::size_t pending = 0;
+  std::uint64_t generation = 0;
+  bool stopping = false;
+  std::exception_ptr error;
+
+  template <typename Task> static void invokeTask(Task &task, std::size_t i, std::size_t slot) {
+    if constexpr (std::is_invocable_v<Task &, std::size_t, std::size_t>) {
+      task(i, slot);
+    } else {
+      task(i);
+    }
+  }
+
+  static std::uint64_t pack(std::uint64_t begin, std::uint64_t end) {
+    return begin << 32 | end;
+  }
+
+  //! @brief Claim the first task of the range of the slot
+  bool popFront(std::size_t slot, std::size_t &i) {
+    std::uint64_t bounds = ranges[slot].bounds.load();
+    while (true) {
+      const std::uint64_t begin = bounds >> 32, end = bounds & 0xFFFFFFFFULL;
+      if (begin >= end) {
+        return false;
+      }
+      if (ranges[slot].bounds.compare_exchange_weak(bounds, pack(begin + 1, end))) {
+        i = begin;
+        return true;
+      }
+    }
+  }
+
+  //! @brief Claim the back half of the range of another slot. We run its first task and keep the rest as our range.
+  bool steal(std::size_t slot, std::size_t &i) {
+    for (std::size_t k = 1; k < size(); ++k) {
+      Range &victim = ranges[(slot + k) % size()];
+      std::uint64_t bounds = victim.bounds.load();
+      while (true) {
+        const std::uint64_t begin = bounds >> 32, end = bounds & 0xFFFFFFFFULL;
+        if (begin >= end) {
+          break;
+        }
+        const std::uint64_t half = (end - begin + 1) / 2;
+        if (victim.bounds.compare_exchange_weak(bounds, pack(begin, end - half))) {
+          i = end - half;
+          // Our range is empty, and nobody else modifies an empty range.
+          ranges[slot].bounds = pack(end - half + 1, end);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  void runTasks(std::size_t slot) {
+    std::size_t i;
+    while (!cancelled && (popFront(slot, i) || steal(slot, i))) {
+      try {
+        invoke(taskContext, i, slot);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        cancelled = true;
+      }
+    }
+  }
+
+  void work(std::size_t slot) {
+    std::uint64_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeUp.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) {
+          return;
+        }
+        seen = generation;
+      }
+      runTasks(slot);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0) {
+          finished.notify_one();
+        }
+      }
+    }
+  }
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "signature.hh"
+#include "string_pool.hh"
 #include <iostream>
 #include <istream>
 #include <string>
@@ -7,15 +8,31 @@
 
 template <typename Number, typename TimeStamp = double> struct TimedWordEvent {
   std::size_t actionId;
-  std::vector<std::string> strings;
+  std::vector<InternedString> strings;
   std::vector<Number> numbers;
   TimeStamp timestamp;
 };
 
+/*!
+  @brief Abstract class of the parsers of a timed word
+  @sa TimedWordParser, MmapTimedWordParser
+ */
+template <typename Number, typename TimeStamp = double> class AbstractTimedWordParser {
+public:
+  virtual ~AbstractTimedWordParser() = default;
+  /*!
+    @brief Parse and return an event with data
+    @retval true If the parse succeeded
+    @retval false If the parse failed
+   */
+  virtual bool parse(TimedWordEvent<Number, TimeStamp> &event) = 0;
+};
+
 /*!
   @brief Parser of a timed word
  */
-template <typename Number, typename TimeStamp = double> class TimedWordParser {
+template <typename Number, typename TimeStamp = double>
+class TimedWordParser : public AbstractTimedWordParser<Number, TimeStamp> {
 public:
   TimedWordParser(std::istream &is, const Signature &sig) : is(is), sig(sig) {
   }
@@ -24,7 +41,7 @@ public:
     @retval true If the parse succeeded
     @retval false If the parse failed
    */
-  bool parse(TimedWordEvent<Number, TimeStamp> &event) {
+  bool parse(TimedWordEvent<Number, TimeStamp> &event) override {
     // Continuously parse events from the input stream until an event is successfully parsed
     // or the end of the stream is reached. The loop terminates on EOF, empty action, or successful parsing.
     while (true) {
@@ -36,20 +53,20 @@ public:
       if (action.empty()) {
         return false;
       }
-      if (!sig.isDefined(action)) {
+      const Signature::Entry *entry = sig.find(action);
+      if (!entry) {
         std::string skipped;
         std::getline(is, skipped);
         std::cerr << "Undefined action: " << action.c_str() << std::endl;
         continue;
       }
-      const std::size_t stringSize = sig.getStringSize(action);
-      const std::size_t numberSize = sig.getNumberSize(action);
-      event.actionId = sig.getId(action);
+      const std::size_t stringSize = entry->stringSize;
+      const std::size_t numberSize = entry->numberSize;
+      event.actionId = entry->id;
       event.strings.resize(stringSize);
       for (std::size_t i = 0; i < stringSize; i++) {
-        std::string str;
         is >> str;
-        event.strings[i] = std::move(str);
+        event.strings[i] = InternedString(str);
       }
       event.numbers.resize(numberSize);
       for (std::size_t i = 0; i < numberSize; i++) {
@@ -65,4 +82,6 @@ public:
 private:
   std::istream &is;
   const Signature &sig;
+  //! @brief The buffer to read strings
+  std::string str;
 };
@@ -2,20 +2,41 @@
 
 #include "subject.hh"
 #include "timed_word_parser.hh"
+#include <algorithm>
 #include <memory>
+#include <vector>
 
+/*!
+  @brief Subject notifying the events parsed from a timed word
+
+  The events are parsed into a batch and notified by Observer::notifyBatch. The storage of the events in the batch is
+  reused, so the parser does not reallocate their vectors.
+
+  @note The observer receives no event until a batch is full or the timed word ends. For online monitoring with a low
+  latency, use the batch size 1.
+ */
 template <typename Number, typename TimeStamp = double>
 class TimedWordSubject : public SingleSubject<TimedWordEvent<Number, TimeStamp>> {
 public:
-  TimedWordSubject(std::unique_ptr<TimedWordParser<Number, TimeStamp>> parser) : parser(std::move(parser)) {
+  static constexpr std::size_t defaultBatchSize = 1024;
+
+  TimedWordSubject(std::unique_ptr<AbstractTimedWordParser<Number, TimeStamp>> parser,
+                   std::size_t batchSize = defaultBatchSize)
+      : parser(std::move(parser)), batchSize(std::max<std::size_t>(batchSize, 1)) {
   }
   void parseAndSubjectAll() const {
-    TimedWordEvent<Number, TimeStamp> event;
-    while (parser->parse(event)) {
-      this->notifyObservers(event);
-    }
+    std::vector<TimedWordEvent<Number, TimeStamp>> batch(batchSize);
+    std::size_t size;
+    do {
+      size = 0;
+      while (size < batch.size() && parser->parse(batch[size])) {
+        size++;
+      }
+      this->notifyObserversBatch(batch.data(), size);
+    } while (size == batch.size());
   }
 
 private:
-  std::unique_ptr<TimedWordParser<Number, TimeStamp>> parser;
+  std::unique_ptr<AbstractTimedWordParser<Number, TimeStamp>> parser;
+  const std::size_t batchSize;
 };
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <algorithm>
+#include <boost/container/small_vector.hpp>
+#include <boost/functional/hash.hpp>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <optional>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "common_types.hh"
@@ -106,13 +111,127 @@ public:
 //     }), guard.end());
 // }
 
-using TimingValuation = std::vector<TimingConstraint::Timestamp>;
+//! @brief The clock valuation. It is stored inline if there are at most four clocks.
+using TimingValuation = boost::container::small_vector<TimingConstraint::Timestamp, 4>;
 
-static bool eval(const TimingValuation &clockValuation, const std::vector<TimingConstraint> &guard) {
+/*!
+  @brief Check if the clock valuation satisfies the guard.
+
+  @tparam Valuation TimingValuation or std::vector<double>
+ */
+template <typename Valuation>
+static bool eval(const Valuation &clockValuation, const std::vector<TimingConstraint> &guard) {
   return std::all_of(guard.begin(), guard.end(),
                      [&clockValuation](const TimingConstraint &g) { return g.satisfy(clockValuation.at(g.x)); });
 }
 
+/*!
+  @brief A guard normalized to the lower and the upper bounds of each constrained clock
+
+  The constraints on the same clock are intersected when the automaton is loaded. Checking a clock valuation is a
+  loop over the constrained clocks without branches on the kind of the constraints.
+ */
+class TimingBounds {
+public:
+  using Timestamp = TimingConstraint::Timestamp;
+
+  //! @brief The bounds of a clock. The lower and the upper bounds are infinite if they are not constrained.
+  struct Bound {
+    ClockVariables x;
+    Timestamp lower = -std::numeric_limits<Timestamp>::infinity();
+    Timestamp upper = std::numeric_limits<Timestamp>::infinity();
+    bool lowerStrict = false;
+    bool upperStrict = false;
+
+    void restrictLower(Timestamp c, bool strict) {
+      if (c > lower || (c == lower && strict)) {
+        lower = c;
+        lowerStrict = strict;
+      }
+    }
+    void restrictUpper(Timestamp c, bool strict) {
+      if (c < upper || (c == upper && strict)) {
+        upper = c;
+        upperStrict = strict;
+      }
+    }
+  };
+
+  //! @brief The guard without any constraint
+  TimingBounds() = default;
+
+  explicit TimingBounds(const std::vector<TimingConstraint> &guard) {
+    for (const TimingConstraint &g: guard) {
+      auto it = std::find_if(bounds.begin(), bounds.end(), [&g](const Bound &bound) { return bound.x == g.x; });
+      if (it == bounds.end()) {
+        it = bounds.insert(bounds.end(), Bound{g.x});
+      }
+      if (g.odr != TimingConstraint::Order::lt && g.odr != TimingConstraint::Order::le) {
+        it->restrictLower(g.c, g.odr == TimingConstraint::Order::gt);
+      }
+      if (g.odr != TimingConstraint::Order::gt && g.odr != TimingConstraint::Order::ge) {
+        it->restrictUpper(g.c, g.odr == TimingConstraint::Order::lt);
+      }
+    }
+    satisfiable = std::all_of(bounds.begin(), bounds.end(), [](const Bound &bound) {
+      return bound.lower < bound.upper || (bound.lower == bound.upper && !bound.lowerStrict && !bound.upperStrict);
+    });
+  }
+
+  //! @brief Returns false if no clock valuation satisfies the guard.
+  [[nodiscard]] bool isSatisfiable() const {
+    return satisfiable;
+  }
+
+  //! @brief Returns the number of the clocks needed to evaluate the guard.
+  [[nodiscard]] ClockVariables clockSize() const {
+    ClockVariables size = 0;
+    for (const Bound &bound: bounds) {
+      size = std::max<ClockVariables>(size, bound.x + 1);
+    }
+    return size;
+  }
+
+  //! @brief Returns the bounds of the constrained clocks.
+  [[nodiscard]] const boost::container::small_vector<Bound, 2> &clockBounds() const {
+    return bounds;
+  }
+
+  /*!
+    @brief Raise maxConstants[x] to the largest finite constant compared with each clock x in the guard.
+
+    @pre maxConstants has at least clockSize() elements.
+   */
+  void updateMaxConstants(std::vector<Timestamp> &maxConstants) const {
+    for (const Bound &bound: bounds) {
+      for (const Timestamp c: {bound.lower, bound.upper}) {
+        if (std::isfinite(c)) {
+          maxConstants[bound.x] = std::max(maxConstants[bound.x], c);
+        }
+      }
+    }
+  }
+
+  /*!
+    @brief Check if the clock valuation satisfies the guard.
+
+    @pre clockValuation has at least clockSize() clocks.
+   */
+  template <typename Valuation> [[nodiscard]] bool satisfy(const Valuation &clockValuation) const {
+    bool result = satisfiable;
+    for (const Bound &bound: bounds) {
+      const Timestamp d = clockValuation[bound.x];
+      result &= ((d > bound.lower) | ((d == bound.lower) & !bound.lowerStrict)) &
+                ((d < bound.upper) | ((d == bound.upper) & !bound.upperStrict));
+    }
+    return result;
+  }
+
+private:
+  boost::container::small_vector<Bound, 2> bounds;
+  bool satisfiable = true;
+};
+
 /*!
   @brief Calculate the difference needed to satisfy all equality timing constraints in the guard.
 
@@ -122,7 +241,8 @@ static bool eval(const TimingValuation &clockValuation, const std::vector<Timing
   and throws if any non-equality constraint is present.
 
 */
-static std::optional<double> diff(const TimingValuation &clockValuation, const std::vector<TimingConstraint> &guard) {
+template <typename Valuation>
+static std::optional<double> diff(const Valuation &clockValuation, const std::vector<TimingConstraint> &guard) {
   std::optional<double> result = std::nullopt;
   for (auto&& g: guard) {
     if(g.odr != TimingConstraint::Order::eq) {
@@ -141,6 +261,48 @@ static std::optional<double> diff(const TimingValuation &clockValuation, const s
   return result;
 }
 
+/*!
+  @name The operations on the clock valuations in the monitors
+
+  The monitors take a transition by these operations so that they also work on Zone, which provides the same ones.
+ */
+//! @{
+//! @brief Let the given duration elapse.
+inline void elapse(TimingValuation &clockValuation, TimingConstraint::Timestamp duration) {
+  for (auto &d: clockValuation) {
+    d += duration;
+  }
+}
+
+inline void reset(TimingValuation &clockValuation, ClockVariables x) {
+  clockValuation[x] = 0;
+}
+
+//! @brief Returns if the clock valuation may satisfy the guard. For a clock valuation, this is exact.
+inline bool intersects(const TimingValuation &clockValuation, const TimingBounds &guard) {
+  return guard.satisfy(clockValuation);
+}
+
+//! @brief Restrict the clock valuation to the guard, and returns false if nothing is left.
+inline bool constrain(TimingValuation &clockValuation, const TimingBounds &guard) {
+  return guard.satisfy(clockValuation);
+}
+
+//! @brief A clock valuation is not abstracted.
+inline void extrapolate(TimingValuation &, const std::vector<TimingConstraint::Timestamp> &) {
+}
+
+inline void hashClockValuation(std::size_t &seed, const TimingValuation &clockValuation) {
+  boost::hash_range(seed, clockValuation.begin(), clockValuation.end());
+}
+
+//! @brief Returns the infimum of the clock x and whether it is excluded, e.g., to compare it with GuardHorizons.
+inline std::pair<TimingConstraint::Timestamp, bool> clockLowerBound(const TimingValuation &clockValuation,
+                                                                    ClockVariables x) {
+  return {clockValuation[x], false};
+}
+//! @}
+
 /*!
  * @brief Shift the clock variables in the guard by a given width.
  *
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "common_types.hh"
+#include "timing_constraint.hh"
+
+/*!
+  @brief A zone of clock valuations represented by a difference bound matrix (DBM)
+
+  The entry (i, j) is the bound of x_i - x_j, where x_0 is the constant zero and x_{i + 1} is the clock i. The matrix
+  is always kept canonical (i.e., every bound is the tightest one), so two zones are equal if and only if their
+  matrices are equal.
+
+  In the monitors, the timestamps are concrete and a zone is a single clock valuation until it is extrapolated.
+  extrapolate() forgets the value of a clock beyond the largest constant compared with it. Such a value does not
+  change the truth of any guard until the clock is reset, and thus the configurations differing only in such values
+  are merged.
+
+  @note We do not support the diagonal constraints (e.g., x - y < c), for which the extrapolation is not sound.
+ */
+class Zone {
+public:
+  using Timestamp = TimingConstraint::Timestamp;
+
+  //! @brief A bound (value, strict) meaning "< value" if strict and "<= value" otherwise
+  struct Bound {
+    Timestamp value;
+    bool strict;
+
+    static constexpr Bound infinity() {
+      return {std::numeric_limits<Timestamp>::infinity(), true};
+    }
+    [[nodiscard]] bool isInfinity() const {
+      return value == std::numeric_limits<Timestamp>::infinity();
+    }
+    bool operator<(const Bound &other) const {
+      return value < other.value || (value == other.value && strict && !other.strict);
+    }
+    bool operator==(const Bound &other) const {
+      return value == other.value && strict == other.strict;
+    }
+    Bound operator+(const Bound &other) const {
+      if (isInfinity() || other.isInfinity()) {
+        return infinity();
+      }
+      return {value + other.value, strict || other.strict};
+    }
+  };
+
+  //! @brief The zone where all the clocks are zero
+  explicit Zone(std::size_t clockSize = 0) : size(clockSize + 1), dbm(size * size, Bound{0, false}) {
+  }
+
+  [[nodiscard]] std::size_t clockSize() const {
+    return size - 1;
+  }
+
+  //! @brief Returns the bound of x_i - x_j, where x_0 is zero and x_{i + 1} is the clock i.
+  [[nodiscard]] const Bound &at(std::size_t i, std::size_t j) const {
+    return dbm[i * size + j];
+  }
+
+  //! @brief Let the given duration elapse. This shifts the zone and keeps it canonical.
+  void elapse(Timestamp duration) {
+    for (std::size_t i = 1; i < size; ++i) {
+      bound(i, 0).value += duration;
+      bound(0, i).value -= duration;
+    }
+  }
+
+  //! @brief Reset the clock to zero. This keeps the zone canonical.
+  void reset(ClockVariables x) {
+    const std::size_t i = x + 1;
+    for (std::size_t j = 0; j < size; ++j) {
+      bound(i, j) = bound(0, j);
+      bound(j, i) = bound(j, 0);
+    }
+    bound(i, i) = {0, false};
+  }
+
+  /*!
+    @brief Returns if the zone may intersect with the guard.
+
+    It compares the range of each clock with its bounds in the guard. It is exact for a guard on one clock, and it is a
+    necessary condition for the other guards.
+   */
+  [[nodiscard]] bool intersects(const TimingBounds &guard) const {
+    if (!guard.isSatisfiable()) {
+      return false;
+    }
+    for (const auto &clockBound: guard.clockBounds()) {
+      const std::size_t i = clockBound.x + 1;
+      // The range of x is [lower, upper], and we compare -x with the negated lower bounds.
+      const Bound upper = std::min(at(i, 0), Bound{clockBound.upper, clockBound.upperStrict});
+      const Bound negatedLower = std::min(at(0, i), Bound{-clockBound.lower, clockBound.lowerStrict});
+      if (upper + negatedLower < Bound{0, false}) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //! @brief Intersect the zone with the guard, and returns false if the result is empty.
+  bool constrain(const TimingBounds &guard) {
+    if (!guard.isSatisfiable()) {
+      return false;
+    }
+    bool changed = false;
+    for (const auto &clockBound: guard.clockBounds()) {
+      const std::size_t i = clockBound.x + 1;
+      changed |= tighten(i, 0, {clockBound.upper, clockBound.upperStrict});
+      changed |= tighten(0, i, {-clockBound.lower, clockBound.lowerStrict});
+    }
+    return !changed || close();
+  }
+
+  /*!
+    @brief Apply the extrapolation by the maximum constants.
+
+    @param maxConstants The largest constant compared with each clock. It is -infinity if the clock is never compared.
+   */
+  void extrapolate(const std::vector<Timestamp> &maxConstants) {
+    const auto maxConstant = [&maxConstants](std::size_t i) { return i == 0 ? 0 : maxConstants[i - 1]; };
+    bool changed = false;
+    for (std::size_t i = 0; i < size; ++i) {
+      for (std::size_t j = 0; j < size; ++j) {
+        Bound &b = bound(i, j);
+        if (i == j || b.isInfinity()) {
+          continue;
+        }
+        if (b.value > maxConstant(i)) {
+          b = Bound::infinity();
+          changed = true;
+        } else if (b.value < -maxConstant(j)) {
+          b = std::isinf(maxConstant(j)) ? Bound::infinity() : Bound{-maxConstant(j), true};
+          changed = true;
+        }
+      }
+    }
+    if (changed) {
+      close();
+    }
+  }
+
+  /*!
+    @brief Calculate the delay needed to satisfy all equality timing constraints in the guard.
+
+    @returns The delay, or std::nullopt if the equalities imply different delays, a negative delay, or a clock without
+    a single value. After extrapolation, such a clock is larger than any constant compared with it.
+    @throws std::runtime_error If a non-equality constraint is present.
+   */
+  [[nodiscard]] std::optional<Timestamp> delay(const std::vector<TimingConstraint> &guard) const {
+    std::optional<Timestamp> result = std::nullopt;
+    for (const TimingConstraint &g: guard) {
+      if (g.odr != TimingConstraint::Order::eq) {
+        throw std::runtime_error(
+            "TimingConstraint: unsupported guard with inequality constraints on unobservable transition");
+      }
+      const std::size_t i = g.x + 1;
+      if (at(i, 0).strict || at(0, i).strict || at(i, 0).isInfinity() || at(i, 0).value != -at(0, i).value) {
+        return std::nullopt;
+      }
+      const Timestamp timeDiff = g.c - at(i, 0).value;
+      if (timeDiff < 0 || (result && *result != timeDiff)) {
+        return std::nullopt;
+      }
+      result = timeDiff;
+    }
+    return result.value_or(0.0);
+  }
+
+  //! @brief Returns if this zone contains the other zone.
+  [[nodiscard]] bool contains(const Zone &other) const {
+    if (size != other.size) {
+      return false;
+    }
+    for (std::size_t k = 0; k < dbm.size(); ++k) {
+      if (dbm[k] < other.dbm[k]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator==(const Zone &other) const {
+    return dbm == other.dbm;
+  }
+  bool operator!=(const Zone &other) const {
+    return !(*this == other);
+  }
+
+  friend std::size_t hash_value(const Zone &zone) {
+    std::size_t seed = zone.size;
+    for (const Bound &b: zone.dbm) {
+      boost::hash_combine(seed, b.value);
+      boost::hash_combine(seed, b.strict);
+    }
+    return seed;
+  }
+
+  //! @brief Returns the approximate heap memory of the zone.
+  friend std::size_t externalMemoryInBytes(const Zone &zone) {
+    return zone.dbm.capacity() * sizeof(Bound);
+  }
+
+private:
+  std::size_t size;
+  std::vector<Bound> dbm;
+
+  Bound &bound(std::size_t i, std::size_t j) {
+    return dbm[i * size + j];
+  }
+
+  //! @brief Replace the bound of x_i - x_j if the given one is tighter.
+  bool tighten(std::size_t i, std::size_t j, const Bound &b) {
+    if (b < bound(i, j)) {
+      bound(i, j) = b;
+      return true;
+    }
+    return false;
+  }
+
+  //! @brief Make the matrix canonical by Floyd-Warshall, and returns false if the zone is empty.
+  bool close() {
+    for (std::size_t k = 0; k < size; ++k) {
+      for (std::size_t i = 0; i < size; ++i) {
+        if (bound(i, k).isInfinity()) {
+          continue;
+        }
+        for (std::size_t j = 0; j < size; ++j) {
+          tighten(i, j, bound(i, k) + bound(k, j));
+        }
+      }
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      if (bound(i, i) < Bound{0, false}) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+/*!
+  @name The operations on the zones in the monitors
+
+  They are the counterparts of the ones on TimingValuation.
+ */
+//! @{
+inline void elapse(Zone &zone, Zone::Timestamp duration) {
+  zone.elapse(duration);
+}
+
+inline void reset(Zone &zone, ClockVariables x) {
+  zone.reset(x);
+}
+
+inline bool intersects(const Zone &zone, const TimingBounds &guard) {
+  return zone.intersects(guard);
+}
+
+inline bool constrain(Zone &zone, const TimingBounds &guard) {
+  return zone.constrain(guard);
+}
+
+inline void extrapolate(Zone &zone, const std::vector<Zone::Timestamp> &maxConstants) {
+  zone.extrapolate(maxConstants);
+}
+
+inline std::optional<double> diff(const Zone &zone, const std::vector<TimingConstraint> &guard) {
+  return zone.delay(guard);
+}
+
+inline void hashClockValuation(std::size_t &seed, const Zone &zone) {
+  boost::hash_combine(seed, zone);
+}
+
+inline std::pair<Zone::Timestamp, bool> clockLowerBound(const Zone &zone, ClockVariables x) {
+  const Zone::Bound &negatedLower = zone.at(0, x + 1);
+  return {-negatedLower.value, negatedLower.strict};
+}
+//! @}
@@ -284,7 +284,7 @@ BOOST_AUTO_TEST_SUITE(AutomatonParserTests)
                 std::get<std::size_t>(TA.states[0]->next.at(0).at(1).stringConstraints.front().children[0].value), 0ul);
         BOOST_CHECK_EQUAL(TA.states[0]->next.at(0).at(1).stringConstraints.front().children[1].value.index(), 1);
         BOOST_CHECK_EQUAL(
-                std::get<std::string>(TA.states[0]->next.at(0).at(1).stringConstraints.front().children[1].value), "y");
+                std::get<InternedString>(TA.states[0]->next.at(0).at(1).stringConstraints.front().children[1].value), "y");
         BOOST_CHECK_EQUAL(TA.states[0]->next.at(0).at(1).numConstraints.size(), 0);
         BOOST_CHECK_EQUAL(TA.states[0]->next.at(0).at(1).update.stringUpdate.size(), 0);
         BOOST_CHECK_EQUAL(TA.states[0]->next.at(0).at(1).update.numberUpdate.size(), 1);
@@ -306,7 +306,7 @@ BOOST_AUTO_TEST_SUITE(AutomatonParserTests)
                 std::get<std::size_t>(TA.states[1]->next.at(0).at(0).stringConstraints.front().children[0].value), 0ul);
         BOOST_CHECK_EQUAL(TA.states[1]->next.at(0).at(0).stringConstraints.front().children[1].value.index(), 1);
         BOOST_CHECK_EQUAL(
-                std::get<std::string>(TA.states[1]->next.at(0).at(0).stringConstraints.front().children[1].value), "x");
+                std::get<InternedString>(TA.states[1]->next.at(0).at(0).stringConstraints.front().children[1].value), "x");
         BOOST_CHECK_EQUAL(TA.states[1]->next.at(0).at(0).numConstraints.size(), 1);
         BOOST_TEST((TA.states[1]->next.at(0).at(0).numConstraints.front().kind ==
                     NonSymbolic::NumberComparatorKind::NE));
@@ -385,7 +385,7 @@ BOOST_AUTO_TEST_SUITE(AutomatonParserTests)
                 std::get<std::size_t>(TA.states[0]->next.at(0).at(1).stringConstraints.front().children[0].value), 0ul);
         BOOST_CHECK_EQUAL(TA.states[0]->next.at(0).at(1).stringConstraints.front().children[1].value.index(), 1);
         BOOST_CHECK_EQUAL(
-                std::get<std::string>(TA.states[0]->next.at(0).at(1).stringConstraints.front().children[1].value), "y");
+                std::get<InternedString>(TA.states[0]->next.at(0).at(1).stringConstraints.front().children[1].value), "y");
         BOOST_CHECK_EQUAL(TA.states[0]->next.at(0).at(1).numConstraints.size(), 0);
         BOOST_CHECK_EQUAL(TA.states[0]->next.at(0).at(1).update.stringUpdate.size(), 0);
         BOOST_CHECK_EQUAL(TA.states[0]->next.at(0).at(1).update.numberUpdate.size(), 1);
@@ -407,7 +407,7 @@ BOOST_AUTO_TEST_SUITE(AutomatonParserTests)
                 std::get<std::size_t>(TA.states[1]->next.at(0).at(0).stringConstraints.front().children[0].value), 0ul);
         BOOST_CHECK_EQUAL(TA.states[1]->next.at(0).at(0).stringConstraints.front().children[1].value.index(), 1);
         BOOST_CHECK_EQUAL(
-                std::get<std::string>(TA.states[1]->next.at(0).at(0).stringConstraints.front().children[1].value), "x");
+                std::get<InternedString>(TA.states[1]->next.at(0).at(0).stringConstraints.front().children[1].value), "x");
         BOOST_CHECK_EQUAL(TA.states[1]->next.at(0).at(0).numConstraints.size(), 1);
         BOOST_TEST(TA.states[1]->next.at(0).at(0).numConstraints.at(0).is_equal_to(Variable(0) > Variable(1)));
 
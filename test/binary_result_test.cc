@@ -0,0 +1,164 @@
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../src/binary_result.hh"
+#include "../src/printer.hh"
+
+BOOST_AUTO_TEST_SUITE(BinaryResultTest)
+
+//! @brief Returns the text printed from the results and the text printed from their records in the binary format.
+template <typename Printer, typename Result>
+std::pair<std::string, std::string> printTexts(const std::vector<Result> &results) {
+  std::ostringstream text, binary, converted;
+  {
+    Printer textPrinter(OutputFormat::Text, text);
+    Printer binaryPrinter(OutputFormat::Binary, binary);
+    for (const auto &result: results) {
+      textPrinter.notify(result);
+      binaryPrinter.notify(result);
+    }
+  }
+  std::istringstream is(binary.str());
+  BinaryResult::Reader reader(is);
+  {
+    Printer convertedPrinter(OutputFormat::Text, converted);
+    BinaryResult::Record record;
+    while (reader.next(record)) {
+      convertedPrinter.printRecord(record);
+    }
+  }
+  return {text.str(), converted.str()};
+}
+
+BOOST_AUTO_TEST_CASE(boolean) {
+  const std::vector<BooleanMonitorResult<double>> results = {
+      {0, 0.5, {1.25, 3}, {InternedString("foo"), std::nullopt}},
+      {3, 1e9, {-0.1, 42}, {std::nullopt, InternedString("bar\tbaz")}},
+  };
+  std::ostringstream expected, binary;
+  {
+    BooleanPrinter<double> text(OutputFormat::Text, expected);
+    BooleanPrinter<double> printer(OutputFormat::Binary, binary);
+    for (const auto &result: results) {
+      text.notify(result);
+      printer.notify(result);
+    }
+  }
+
+  std::istringstream is(binary.str());
+  BinaryResult::Reader reader(is);
+  BOOST_TEST((reader.kind() == BinaryResult::Kind::Boolean));
+  std::ostringstream converted;
+  {
+    BooleanPrinter<double> text(OutputFormat::Text, converted);
+    BinaryResult::Record record;
+    std::size_t size = 0;
+    while (reader.next(record)) {
+      BOOST_REQUIRE_LT(size, results.size());
+      BOOST_CHECK_EQUAL(record.index, results[size].index);
+      BOOST_CHECK_EQUAL(record.numberValuation.size(), 2);
+      BOOST_CHECK_EQUAL(record.stringValuation[0].kind == BinaryResult::StringKind::Equal, size == 0);
+      text.notify(decodeBooleanResult<double>(record));
+      ++size;
+    }
+    BOOST_CHECK_EQUAL(size, results.size());
+  }
+  BOOST_CHECK_EQUAL(converted.str(), expected.str());
+}
+
+BOOST_AUTO_TEST_CASE(polyhedra) {
+  using namespace Parma_Polyhedra_Library;
+  NNC_Polyhedron numberValuation(1);
+  numberValuation.add_constraint(5 * Variable(0) == 2);
+  ParametricMonitorResult result{7, PPLRational(21, 10), numberValuation, {}, NNC_Polyhedron(2)};
+  result.stringValuation.emplace_back(std::vector<InternedString>{"b", "a"});
+  result.stringValuation.emplace_back(InternedString("c"));
+  result.parametricTimingValuation.add_constraint(Variable(1) - Variable(0) < 3);
+  result.parametricTimingValuation.add_constraint(Variable(0) >= 0);
+  std::ostringstream binary;
+  {
+    ParametricPrinter printer(OutputFormat::Binary, binary);
+    printer.notify(result);
+    result.numberValuation = NNC_Polyhedron(1, EMPTY);
+    printer.notify(result);
+  }
+
+  std::istringstream is(binary.str());
+  BinaryResult::Reader reader(is);
+  BOOST_TEST((reader.kind() == BinaryResult::Kind::Parametric));
+  BinaryResult::Record record;
+  BOOST_REQUIRE(reader.next(record));
+  auto decoded = decodeParametricResult(record);
+  BOOST_CHECK_EQUAL(decoded.index, 7);
+  BOOST_CHECK_EQUAL(decoded.timestamp, PPLRational(21, 10));
+  BOOST_TEST((decoded.numberValuation == numberValuation));
+  BOOST_TEST((decoded.parametricTimingValuation == result.parametricTimingValuation));
+  BOOST_REQUIRE_EQUAL(decoded.stringValuation.size(), 2);
+  // The strings are sorted.
+  BOOST_CHECK_EQUAL(record.stringValuation[0].strings.front(), "a");
+  BOOST_CHECK_EQUAL(std::get<1>(decoded.stringValuation[1]), InternedString("c"));
+
+  BOOST_REQUIRE(reader.next(record));
+  decoded = decodeParametricResult(record);
+  BOOST_TEST(decoded.numberValuation.is_empty());
+  BOOST_TEST(!reader.next(record));
+}
+
+// The converted text is the same as the text of the symbolic monitors, including the order of the constraints.
+BOOST_AUTO_TEST_CASE(text) {
+  using namespace Parma_Polyhedra_Library;
+  NNC_Polyhedron numberValuation(2);
+  numberValuation.add_constraint(Variable(0) + 2 * Variable(1) <= 7);
+  numberValuation.add_constraint(Variable(1) > 0);
+  numberValuation.add_constraint(3 * Variable(0) == 4);
+  NNC_Polyhedron timingValuation(3);
+  timingValuation.add_constraint(Variable(2) - Variable(0) < 3);
+  timingValuation.add_constraint(Variable(1) >= Variable(0));
+  timingValuation.add_constraint(Variable(0) >= 0);
+  Symbolic::StringValuation stringValuation;
+  stringValuation.emplace_back(std::vector<InternedString>{"b", "a"});
+  stringValuation.emplace_back(InternedString("c"));
+
+  const std::vector<DataParametricMonitorResult> dataParametricResults = {
+      {3, 1.25, numberValuation, stringValuation},
+      {4, 2, NNC_Polyhedron(2), stringValuation},
+      {5, 3, NNC_Polyhedron(2, EMPTY), {}},
+  };
+  const auto [dataParametricText, dataParametricConverted] = printTexts<DataParametricPrinter>(dataParametricResults);
+  BOOST_TEST(!dataParametricText.empty());
+  BOOST_CHECK_EQUAL(dataParametricConverted, dataParametricText);
+
+  const std::vector<ParametricMonitorResult> parametricResults = {
+      {3, PPLRational(5, 4), numberValuation, stringValuation, timingValuation},
+      {4, 2, NNC_Polyhedron(2), stringValuation, NNC_Polyhedron(3, EMPTY)},
+  };
+  const auto [parametricText, parametricConverted] = printTexts<ParametricPrinter>(parametricResults);
+  BOOST_TEST(!parametricText.empty());
+  BOOST_CHECK_EQUAL(parametricConverted, parametricText);
+}
+
+BOOST_AUTO_TEST_CASE(malformed) {
+  std::istringstream text("@0.500000.\t(time-point 0)\t\n");
+  BOOST_CHECK_THROW(BinaryResult::Reader{text}, std::runtime_error);
+
+  std::ostringstream binary;
+  {
+    BooleanPrinter<double> printer(OutputFormat::Binary, binary);
+    printer.notify({0, 0.5, {}, {}});
+  }
+  // The record is truncated.
+  std::istringstream truncated(binary.str().substr(0, binary.str().size() - 1));
+  BinaryResult::Reader reader(truncated);
+  BinaryResult::Record record;
+  BOOST_CHECK_THROW(reader.next(record), std::runtime_error);
+
+  // The length of the record is much larger than the input.
+  const std::size_t headerSize = BinaryResult::magic.size() + sizeof(std::uint16_t) + sizeof(std::uint8_t);
+  std::istringstream corrupted(binary.str().substr(0, headerSize) + std::string(4, '\xff') + "record");
+  BinaryResult::Reader corruptedReader(corrupted);
+  BOOST_CHECK_THROW(corruptedReader.next(record), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
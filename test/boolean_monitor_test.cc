@@ -2,6 +2,9 @@
 #include "../test/fixture/copy_automaton_fixture.hh"
 #include "../test/fixture/non_integer_timestamp_fixture.hh"
 #include "../test/fixture/epsilon_transition_automaton_fixture.hh"
+#include "../test/fixture/restart_automaton_fixture.hh"
+#include "../test/fixture/timed_word_fixture.hh"
+#include "../test/fixture/check_same_results.hh"
 #include "automaton.hh"
 #include "timed_word_parser.hh"
 #include <boost/mpl/list.hpp>
@@ -19,6 +22,12 @@ struct DummyTimedWordSubject : public SingleSubject<TimedWordEvent> {
     }
     vec.clear();
   }
+  void notifyAllInBatches(std::size_t batchSize) {
+    for (std::size_t i = 0; i < vec.size(); i += batchSize) {
+      this->notifyObserversBatch(vec.data() + i, std::min(batchSize, vec.size() - i));
+    }
+    vec.clear();
+  }
   std::vector<TimedWordEvent> vec;
 };
 
@@ -36,19 +45,32 @@ struct DummyBooleanMonitorObserver : public Observer<BooleanMonitorResult<Number
 
 template<typename Number, typename TimedWordEvent>
 struct BooleanMonitorFixture {
-  void feed(const NonParametricTA<Number> &automaton, std::vector<TimedWordEvent> &&vec) {
-    auto monitor = std::make_shared<NonSymbolic::BooleanMonitor<Number>>(automaton);
+  /*!
+    @param batchSize If it is positive, the events are given to the monitor by notifyBatch.
+    @tparam ClockValuation The timing domain of the monitor
+   */
+  template <typename ClockValuation = TimingValuation>
+  void feed(const NonParametricTA<Number> &automaton, std::vector<TimedWordEvent> &&vec, std::size_t threads = 1,
+            std::size_t batchSize = 0, const MonitorBudget &budget = {}) {
+    auto monitor = std::make_shared<NonSymbolic::BooleanMonitor<Number, ClockValuation>>(automaton, threads, budget);
     std::shared_ptr<DummyBooleanMonitorObserver<Number>> observer = std::make_shared<DummyBooleanMonitorObserver<Number>>();
     monitor->addObserver(observer);
     DummyTimedWordSubject<TimedWordEvent> subject{std::move(vec)};
     subject.addObserver(monitor);
-    subject.notifyAll();
+    if (batchSize > 0) {
+      subject.notifyAllInBatches(batchSize);
+    } else {
+      subject.notifyAll();
+    }
     // Ensure the monitor's destructor runs now to emit epsilon-transition notifications
     subject.addObserver(nullptr); // release subject's shared ownership
+    configurationSize = monitor->size();
     monitor.reset();            // release local ownership
     resultVec = std::move(observer->resultVec);
   }
   std::vector<BooleanMonitorResult<Number>> resultVec;
+  //! @brief The number of the configurations after the last event
+  std::size_t configurationSize = 0;
 };
 
 namespace IntTest {
@@ -80,6 +102,120 @@ namespace IntTest {
       BOOST_CHECK_EQUAL(resultVec.front().timestamp, 15.5);
     }
 
+    // The frontier has hundreds of configurations, so the parallel mode splits it into chunks.
+    BOOST_FIXTURE_TEST_CASE(parallel, BooleanMonitorFixture)
+    {
+      const auto makeTimedWord = [] { return TimedWordFixture::makeAlternating<TimedWordEvent>(4000, 0.002, {1}); };
+      feed(CopyFixture().automaton, makeTimedWord());
+      const auto expected = std::move(resultVec);
+      BOOST_REQUIRE(!expected.empty());
+      feed(CopyFixture().automaton, makeTimedWord(), 4);
+      using Result = BooleanMonitorResult<Number>;
+      checkSameResults(resultVec, expected, &Result::numberValuation, &Result::stringValuation);
+    }
+
+    BOOST_FIXTURE_TEST_CASE(batch, BooleanMonitorFixture)
+    {
+      const auto makeTimedWord = [] { return TimedWordFixture::makeAlternating<TimedWordEvent>(100, 0.1, {1}); };
+      feed(CopyFixture().automaton, makeTimedWord());
+      const auto expected = std::move(resultVec);
+      BOOST_REQUIRE(!expected.empty());
+      feed(CopyFixture().automaton, makeTimedWord(), 1, 7);
+      checkSameResults(resultVec, expected);
+    }
+
+    // The clock is reset nondeterministically, and the monitor matches when it is more than 1. The concrete
+    // configurations differ in the clock values, while the zones merge the ones beyond 1.
+    BOOST_FIXTURE_TEST_CASE(zone, BooleanMonitorFixture)
+    {
+      NonParametricTA<Number> automaton;
+      automaton.states = {std::make_shared<NonParametricTAState<Number>>(false),
+                          std::make_shared<NonParametricTAState<Number>>(true)};
+      automaton.initialStates = {automaton.states[0]};
+      automaton.clockVariableSize = 1;
+      automaton.stringVariableSize = 0;
+      automaton.numberVariableSize = 0;
+      automaton.states[0]->next[0] = {{{}, {}, {}, {VariableID{0}}, {}, automaton.states[0]},
+                                      {{}, {}, {}, {}, {}, automaton.states[0]},
+                                      {{}, {}, {}, {}, {ConstraintMaker(0) > 1}, automaton.states[1]}};
+      const auto makeTimedWord = [] { return TimedWordFixture::makePeriodic<TimedWordEvent>(100, 0.3); };
+      feed(automaton, makeTimedWord());
+      const auto expected = std::move(resultVec);
+      const std::size_t expectedSize = configurationSize;
+      feed<Zone>(automaton, makeTimedWord());
+      BOOST_CHECK_LT(configurationSize, 10);
+      BOOST_CHECK_GT(expectedSize, 90);
+      // The successors of different configurations may report the same match.
+      std::vector<std::size_t> expectedIndices, indices;
+      for (const auto &result: expected) {
+        expectedIndices.push_back(result.index);
+      }
+      for (const auto &result: resultVec) {
+        indices.push_back(result.index);
+      }
+      expectedIndices.erase(std::unique(expectedIndices.begin(), expectedIndices.end()), expectedIndices.end());
+      indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+      BOOST_REQUIRE(!expectedIndices.empty());
+      BOOST_TEST(indices == expectedIndices, boost::test_tools::per_element());
+    }
+
+    // A partial match leaves the initial state at every event, and the budget drops the oldest ones.
+    BOOST_FIXTURE_TEST_CASE(budget, BooleanMonitorFixture)
+    {
+      const auto automaton = RestartFixture({ConstraintMaker(0) > 1}).automaton;
+      const auto makeTimedWord = [] { return TimedWordFixture::makePeriodic<TimedWordEvent>(100, 0.3); };
+      feed(automaton, makeTimedWord());
+      BOOST_CHECK_GT(configurationSize, 90);
+
+      const MonitorBudget budget{10, 0, BudgetPolicy::Drop, std::make_shared<BudgetCounters>()};
+      feed(automaton, makeTimedWord(), 1, 0, budget);
+      BOOST_CHECK_EQUAL(configurationSize, 10);
+      BOOST_CHECK_GT(budget.counters->exceeded, 0);
+      BOOST_CHECK_GT(budget.counters->dropped, 0);
+      BOOST_CHECK_GT(budget.counters->peakConfigurations, 10);
+      // The newest partial matches are kept, and they still match.
+      BOOST_REQUIRE(!resultVec.empty());
+      BOOST_CHECK_EQUAL(resultVec.back().index, 99);
+
+      BOOST_CHECK_THROW(feed(automaton, makeTimedWord(), 1, 0, MonitorBudget{10}), std::runtime_error);
+      // The configuration at the initial state is never dropped though it alone exceeds the budget.
+      BOOST_CHECK_THROW(feed(automaton, makeTimedWord(), 1, 0, MonitorBudget{0, 1, BudgetPolicy::Drop}),
+                        std::runtime_error);
+      BOOST_CHECK_THROW(feed(automaton, makeTimedWord(), 1, 0, MonitorBudget{0, 0, BudgetPolicy::Merge}),
+                        std::runtime_error);
+    }
+
+    // A partial match leaves the initial state at every event and must reach the accepting state within 1. The
+    // partial matches beyond the horizon are discarded though their state has an enabled transition.
+    BOOST_FIXTURE_TEST_CASE(horizon, BooleanMonitorFixture)
+    {
+      const auto automaton = RestartFixture({ConstraintMaker(0) < 1}).automaton;
+      const auto makeTimedWord = [] { return TimedWordFixture::makePeriodic<TimedWordEvent>(100, 0.3); };
+      const auto check = [this] {
+        BOOST_CHECK_LT(configurationSize, 10);
+        // Each event is 0.3 after the previous one, so every event after the first one ends three matches.
+        BOOST_CHECK_EQUAL(resultVec.size(), 3 * 99 - 3);
+        BOOST_REQUIRE(!resultVec.empty());
+        BOOST_CHECK_EQUAL(resultVec.front().index, 1);
+        BOOST_CHECK_EQUAL(resultVec.back().index, 99);
+      };
+      feed(automaton, makeTimedWord());
+      check();
+      feed<Zone>(automaton, makeTimedWord());
+      check();
+    }
+
+    BOOST_FIXTURE_TEST_CASE(epsilon_zone, BooleanMonitorFixture)
+    {
+      auto automaton = EpsilonTransitionAutomatonFixture::FIXTURE4.makeBooleanTA();
+      feed<Zone>(automaton, {{0, {"a"}, {}, 1.5}, {0, {"b"}, {}, 2.5}, {0, {"a"}, {}, 3.5}, {0, {"b"}, {}, 4.5}});
+      BOOST_REQUIRE_EQUAL(resultVec.size(), 2);
+      BOOST_CHECK_EQUAL(resultVec[0].index, 2);
+      BOOST_CHECK_EQUAL(resultVec[0].timestamp, 5.5);
+      BOOST_CHECK_EQUAL(resultVec[1].index, 4);
+      BOOST_CHECK_EQUAL(resultVec[1].timestamp, 7.5);
+    }
+
     BOOST_FIXTURE_TEST_CASE(epsilon_test1, BooleanMonitorFixture)
     {
       auto automaton = EpsilonTransitionAutomatonFixture::FIXTURE1.makeBooleanTA();
@@ -187,3 +323,23 @@ namespace DoubleTest {
     }
   BOOST_AUTO_TEST_SUITE_END()
 }
+
+BOOST_AUTO_TEST_SUITE(BooleanConfigurationTest)
+  using Configuration = NonSymbolic::BooleanConfiguration<int>;
+
+  BOOST_AUTO_TEST_CASE(equality) {
+    const Configuration conf1{1, {0.5}, {InternedString("Alice"), std::nullopt}, {std::make_optional(3)}, 2.0};
+    const Configuration conf2{1, {0.5}, {InternedString("Alice"), std::nullopt}, {std::make_optional(3)}, 2.0};
+    BOOST_TEST((conf1 == conf2));
+    BOOST_CHECK_EQUAL(hash_value(conf1), hash_value(conf2));
+  }
+
+  BOOST_AUTO_TEST_CASE(inequality) {
+    const Configuration conf{1, {0.5}, {InternedString("Alice"), std::nullopt}, {std::make_optional(3)}, 2.0};
+    BOOST_TEST(!(conf == Configuration{0, {0.5}, {InternedString("Alice"), std::nullopt}, {std::make_optional(3)}, 2.0}));
+    BOOST_TEST(!(conf == Configuration{1, {1.5}, {InternedString("Alice"), std::nullopt}, {std::make_optional(3)}, 2.0}));
+    BOOST_TEST(!(conf == Configuration{1, {0.5}, {std::nullopt, InternedString("Alice")}, {std::make_optional(3)}, 2.0}));
+    BOOST_TEST(!(conf == Configuration{1, {0.5}, {InternedString("Alice"), std::nullopt}, {std::nullopt}, 2.0}));
+    BOOST_TEST(!(conf == Configuration{1, {0.5}, {InternedString("Alice"), std::nullopt}, {std::make_optional(3)}, 3.0}));
+  }
+BOOST_AUTO_TEST_SUITE_END()
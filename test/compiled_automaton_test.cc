@@ -0,0 +1,57 @@
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include "../src/compiled_automaton.hh"
+#include "fixture/copy_automaton_fixture.hh"
+
+BOOST_AUTO_TEST_SUITE(CompiledAutomatonTest)
+
+using Compiled = CompiledAutomaton<NonParametricTAState<int>>;
+
+std::vector<Compiled::StateIndex> targets(const Compiled::EdgeRange &edges) {
+  std::vector<Compiled::StateIndex> result;
+  for (const auto &edge: edges) {
+    result.push_back(edge.target);
+  }
+  return result;
+}
+
+BOOST_FIXTURE_TEST_CASE(copy, CopyFixture) {
+  const Compiled compiled(automaton);
+  BOOST_CHECK_EQUAL(compiled.stateSize(), 4);
+  BOOST_TEST((compiled.initialStates() == std::vector<Compiled::StateIndex>{0}));
+  for (std::size_t i = 0; i < automaton.states.size(); ++i) {
+    BOOST_CHECK_EQUAL(compiled.isMatch(i), automaton.states[i]->isMatch);
+  }
+
+  BOOST_TEST((targets(compiled.edges(0, 0)) == std::vector<Compiled::StateIndex>{0, 1}));
+  BOOST_TEST((targets(compiled.edges(1, 0)) == std::vector<Compiled::StateIndex>{1, 1, 2}));
+  BOOST_TEST((targets(compiled.edges(2, 0)) == std::vector<Compiled::StateIndex>{2, 2, 1, 3}));
+  BOOST_TEST(compiled.edges(3, 0).empty());
+  BOOST_TEST((targets(compiled.edgesFrom(2)) == std::vector<Compiled::StateIndex>{2, 2, 1, 3}));
+  BOOST_TEST(compiled.edgesFrom(3).empty());
+
+  // The transitions keep their order and their guards
+  const auto edges = compiled.edges(0, 0);
+  BOOST_CHECK_EQUAL(edges.size(), 2);
+  BOOST_CHECK_EQUAL(edges.begin()[1].transition.stringConstraints.size(), 1);
+  BOOST_CHECK_EQUAL(edges.begin()[1].transition.resetVars.size(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(unknownAction, CopyFixture) {
+  const Compiled compiled(automaton);
+  BOOST_TEST(compiled.hasAction(0));
+  BOOST_TEST(!compiled.hasAction(1));
+  BOOST_TEST(!compiled.hasAction(127));
+  BOOST_TEST(compiled.edges(0, 127).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(expiredTarget, CopyFixture) {
+  // The target of the transition is not owned by anyone
+  automaton.states[3]->next[1].push_back(
+      {{}, {}, {}, {}, {}, std::make_shared<NonParametricTAState<int>>(true)});
+  const Compiled compiled(automaton);
+  BOOST_CHECK_EQUAL(compiled.stateSize(), 4);
+  BOOST_TEST(compiled.edges(3, 1).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
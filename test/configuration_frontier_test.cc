@@ -0,0 +1,107 @@
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include "../src/configuration_frontier.hh"
+
+BOOST_AUTO_TEST_SUITE(ConfigurationFrontierTest)
+
+using Frontier = ConfigurationFrontier<std::vector<int>>;
+
+BOOST_AUTO_TEST_CASE(insertUnique) {
+  Frontier frontier;
+  BOOST_TEST(frontier.insert({1, 2}));
+  BOOST_TEST(frontier.insert({2, 1}));
+  BOOST_TEST(!frontier.insert({1, 2}));
+  BOOST_CHECK_EQUAL(frontier.size(), 2);
+  BOOST_TEST((frontier[0] == std::vector<int>{1, 2}));
+  BOOST_TEST((frontier[1] == std::vector<int>{2, 1}));
+}
+
+BOOST_AUTO_TEST_CASE(manyConfigurations) {
+  Frontier frontier;
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_TEST(frontier.insert({i}));
+  }
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_TEST(!frontier.insert({i}));
+  }
+  BOOST_CHECK_EQUAL(frontier.size(), 1000);
+  int expected = 0;
+  for (const auto &conf: frontier) {
+    BOOST_CHECK_EQUAL(conf.front(), expected++);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(clear) {
+  Frontier frontier;
+  frontier.insert({1});
+  frontier.insert({2});
+  frontier.clear();
+  BOOST_TEST(frontier.empty());
+  BOOST_TEST((frontier.begin() == frontier.end()));
+  // The configurations before clear() must not be found
+  BOOST_TEST(frontier.insert({2}));
+  BOOST_TEST(frontier.insert({1}));
+  BOOST_CHECK_EQUAL(frontier.size(), 2);
+}
+
+// The storage of the cleared and the rejected configurations is recycled
+BOOST_AUTO_TEST_CASE(recycle) {
+  Frontier frontier;
+  frontier.insert(std::vector<int>(100, 1));
+  const int *storage = frontier[0].data();
+  frontier.clear();
+  std::vector<int> &scratch = frontier.scratch();
+  BOOST_CHECK_EQUAL(scratch.data(), storage);
+  scratch.assign(50, 2);
+  BOOST_CHECK_EQUAL(scratch.data(), storage);
+  BOOST_TEST(frontier.commit());
+
+  frontier.insert({3});
+  std::vector<int> &duplicate = frontier.scratch();
+  duplicate = {3};
+  BOOST_TEST(!frontier.commit());
+  BOOST_CHECK_EQUAL(&frontier.scratch(), &duplicate);
+  BOOST_CHECK_EQUAL(frontier.size(), 2);
+}
+
+// A configuration {key, n} subsumes {key, m} if n >= m
+BOOST_AUTO_TEST_CASE(removeSubsumed) {
+  Frontier frontier;
+  for (const std::vector<int> &conf: {std::vector<int>{0, 1}, {1, 5}, {0, 3}, {2, 1}, {1, 2}, {0, 2}}) {
+    frontier.insert(conf);
+  }
+  const auto keyHash = [](const std::vector<int> &conf) { return static_cast<std::size_t>(conf[0]); };
+  const auto subsumes = [](const std::vector<int> &left, const std::vector<int> &right) {
+    return left[0] == right[0] && left[1] >= right[1];
+  };
+  BOOST_CHECK_EQUAL(frontier.removeSubsumed(keyHash, subsumes), 3);
+  BOOST_CHECK_EQUAL(frontier.size(), 3);
+  BOOST_TEST((frontier[0] == std::vector<int>{1, 5}));
+  BOOST_TEST((frontier[1] == std::vector<int>{0, 3}));
+  BOOST_TEST((frontier[2] == std::vector<int>{2, 1}));
+  // The hash index is rebuilt for the remaining configurations
+  BOOST_TEST(!frontier.insert({0, 3}));
+  BOOST_TEST(frontier.insert({0, 1}));
+  BOOST_CHECK_EQUAL(frontier.removeSubsumed(keyHash, subsumes), 1);
+  BOOST_CHECK_EQUAL(frontier.size(), 3);
+}
+
+// The configurations {key, n} with the same key are merged into {key, sum of n}
+BOOST_AUTO_TEST_CASE(mergeGroups) {
+  Frontier frontier;
+  for (const std::vector<int> &conf: {std::vector<int>{0, 1}, {1, 5}, {0, 3}, {0, 2}}) {
+    frontier.insert(conf);
+  }
+  const auto keyHash = [](const std::vector<int> &conf) { return static_cast<std::size_t>(conf[0]); };
+  const auto sameKey = [](const std::vector<int> &left, const std::vector<int> &right) { return left[0] == right[0]; };
+  const auto merge = [](std::vector<int> &left, const std::vector<int> &right) { left[1] += right[1]; };
+  BOOST_CHECK_EQUAL(frontier.mergeGroups(keyHash, sameKey, merge), 2);
+  BOOST_CHECK_EQUAL(frontier.size(), 2);
+  BOOST_TEST((frontier[0] == std::vector<int>{0, 6}));
+  BOOST_TEST((frontier[1] == std::vector<int>{1, 5}));
+  // The merged configuration is indexed by its new hash value
+  BOOST_TEST(!frontier.insert({0, 6}));
+  BOOST_TEST(frontier.insert({0, 1}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,8 @@
 #include "../test/fixture/copy_automaton_fixture.hh"
 #include "../test/fixture/non_integer_timestamp_fixture.hh"
 #include "../test/fixture/epsilon_transition_automaton_fixture.hh"
+#include "../test/fixture/timed_word_fixture.hh"
+#include "../test/fixture/check_same_results.hh"
 
 using TWEvent = TimedWordEvent<PPLRational>;
 
@@ -29,8 +31,10 @@ struct DummyDataParametricMonitorObserver : public Observer<DataParametricMonito
 };
 
 struct DataParametricMonitorFixture {
-  void feed(DataParametricTA automaton, std::vector<TWEvent> &&vec) {
-    auto monitor = std::make_shared<DataParametricMonitor>(automaton);
+  template <typename Monitor = DataParametricMonitor>
+  void feed(DataParametricTA automaton, std::vector<TWEvent> &&vec, std::size_t threads = 1,
+            MonitorBudget budget = {}, GuardMemoOptions guardMemo = {}) {
+    auto monitor = std::make_shared<Monitor>(automaton, threads, std::move(budget), std::move(guardMemo));
     std::shared_ptr<DummyDataParametricMonitorObserver> observer = std::make_shared<DummyDataParametricMonitorObserver>();
     monitor->addObserver(observer);
     DummyDataTimedWordSubject subject{std::move(vec)};
@@ -70,6 +74,183 @@ BOOST_FIXTURE_TEST_CASE(test2, DataParametricMonitorFixture)
   BOOST_CHECK_EQUAL(resultVec.front().timestamp, 15.5);
 }
 
+// The frontier has dozens of configurations, so the parallel mode splits it into chunks. More than one thread needs PPL
+// built with thread safety, which the CI builds for this test.
+BOOST_FIXTURE_TEST_CASE(parallel, DataParametricMonitorFixture)
+{
+  const auto makeTimedWord = [] { return TimedWordFixture::makeAlternating<TWEvent>(300, 0.02, {100}); };
+  feed(DataParametricCopy().automaton, makeTimedWord());
+  const auto expected = std::move(resultVec);
+  BOOST_REQUIRE(!expected.empty());
+  if (!DataParametricMonitor::isThreadSafe) {
+    BOOST_CHECK_THROW(feed(DataParametricCopy().automaton, makeTimedWord(), 4), std::runtime_error);
+    return;
+  }
+  feed(DataParametricCopy().automaton, makeTimedWord(), 4);
+  checkSameResults(resultVec, expected, &DataParametricMonitorResult::numberValuation,
+                   &DataParametricMonitorResult::stringValuation);
+}
+
+// The copy automaton compares and copies the data, which are exact in the boxes and the octagons.
+BOOST_FIXTURE_TEST_CASE(numberDomains, DataParametricMonitorFixture)
+{
+  using BoxMonitor = BasicDataParametricMonitor<TimingValuation, Symbolic::BoxNumberValuation>;
+  using OctagonMonitor = BasicDataParametricMonitor<TimingValuation, Symbolic::OctagonNumberValuation>;
+  BOOST_TEST(BoxMonitor::supports(DataParametricCopy().automaton));
+  BOOST_TEST(OctagonMonitor::supports(DataParametricCopy().automaton));
+  const auto makeTimedWord = [] {
+    return std::vector<TWEvent>{
+        {0, {"x"}, {100}, 0.1}, {0, {"y"}, {100, 3}, 10}, {0, {"x"}, {100, 3}, 12}, {0, {"z"}, {100, 3}, 15.5}};
+  };
+  feed(DataParametricCopy().automaton, makeTimedWord());
+  const auto expected = std::move(resultVec);
+  BOOST_REQUIRE_EQUAL(expected.size(), 1);
+  for (int domain = 0; domain < 2; ++domain) {
+    if (domain == 0) {
+      feed<BoxMonitor>(DataParametricCopy().automaton, makeTimedWord());
+    } else {
+      feed<OctagonMonitor>(DataParametricCopy().automaton, makeTimedWord());
+    }
+    checkSameResults(resultVec, expected, &DataParametricMonitorResult::numberValuation);
+  }
+
+  // x0 + x1 >= 0 relates two variables, which a box cannot represent.
+  Symbolic::NumberDomain<Symbolic::BoxNumberValuation> box(2);
+  Symbolic::NumberDomain<Symbolic::OctagonNumberValuation> octagon(2);
+  const std::vector<Symbolic::NumberConstraint> sum{Parma_Polyhedra_Library::Variable(0) +
+                                                        Parma_Polyhedra_Library::Variable(1) >= 0};
+  BOOST_TEST(!box.isExact(sum, {}));
+  BOOST_TEST(octagon.isExact(sum, {}));
+  const std::vector<Symbolic::NumberConstraint> twice{Parma_Polyhedra_Library::Variable(0) * 2 +
+                                                          Parma_Polyhedra_Library::Variable(1) >= 0};
+  BOOST_TEST(!octagon.isExact(twice, {}));
+}
+
+// The configurations share their polyhedra, and the ones taking the same transition from a shared polyhedron share the
+// result.
+BOOST_FIXTURE_TEST_CASE(sharedNumberValuations, DataParametricMonitorFixture)
+{
+  using SharedMonitor = BasicDataParametricMonitor<TimingValuation, Symbolic::SharedNumberValuation>;
+  const auto makeTimedWord = [] { return TimedWordFixture::makeAlternating<TWEvent>(300, 0.02, {100}); };
+  feed(DataParametricCopy().automaton, makeTimedWord());
+  const auto expected = std::move(resultVec);
+  BOOST_REQUIRE(!expected.empty());
+  feed<SharedMonitor>(DataParametricCopy().automaton, makeTimedWord());
+  checkSameResults(resultVec, expected, &DataParametricMonitorResult::numberValuation);
+  BOOST_CHECK_THROW(feed<SharedMonitor>(DataParametricCopy().automaton, makeTimedWord(), 2), std::runtime_error);
+
+  const Symbolic::NumberDomain<Symbolic::SharedNumberValuation> domain(1);
+  const std::vector<Symbolic::NumberConstraint> guard{Parma_Polyhedra_Library::Variable(0) >= 1};
+  const Symbolic::SharedNumberValuation initial(1);
+  Symbolic::SharedNumberValuation left = initial, right = initial;
+  Symbolic::StringValuation stringEnv;
+  domain.beginEvent();
+  BOOST_TEST(domain.eval({}, stringEnv, guard, left, {}));
+  BOOST_TEST(domain.eval({}, stringEnv, guard, right, {}));
+  BOOST_TEST(left.identity() != initial.identity());
+  BOOST_TEST(left.identity() == right.identity());
+  BOOST_TEST(initial.contains(left));
+  BOOST_TEST(!left.contains(initial));
+}
+
+// The results of the guards on the shared polyhedra are memoized across the events, unlike the other results.
+BOOST_FIXTURE_TEST_CASE(guardMemo, DataParametricMonitorFixture)
+{
+  const std::vector<Symbolic::NumberConstraint> guard{Parma_Polyhedra_Library::Variable(0) >= 1};
+  const Symbolic::SharedNumberValuation initial(1);
+  Symbolic::StringValuation stringEnv;
+  for (const std::size_t capacity: {std::size_t{1024}, std::size_t{0}}) {
+    const Symbolic::NumberDomain<Symbolic::SharedNumberValuation> domain(1, capacity);
+    for (int event = 0; event < 2; ++event) {
+      domain.beginEvent();
+      Symbolic::SharedNumberValuation numEnv = initial;
+      BOOST_TEST(domain.eval({}, stringEnv, guard, numEnv, {}));
+      BOOST_TEST(!numEnv.contains(initial));
+    }
+    BOOST_CHECK_EQUAL(domain.guardMemoCounters().hits, capacity > 0 ? 1 : 0);
+    BOOST_CHECK_EQUAL(domain.guardMemoCounters().misses, capacity > 0 ? 1 : 0);
+  }
+
+  // The monitor adds the counters to the options when it is destroyed, and the memo does not change the results.
+  using SharedMonitor = BasicDataParametricMonitor<TimingValuation, Symbolic::SharedNumberValuation>;
+  const auto makeTimedWord = [] { return TimedWordFixture::makeAlternating<TWEvent>(300, 0.02, {100}); };
+  GuardMemoOptions guardMemo;
+  guardMemo.counters = std::make_shared<GuardMemoCounters>();
+  feed<SharedMonitor>(DataParametricCopy().automaton, makeTimedWord(), 1, {}, guardMemo);
+  const auto expected = std::move(resultVec);
+  BOOST_REQUIRE(!expected.empty());
+  // The memo is disabled by default.
+  BOOST_CHECK_EQUAL(guardMemo.counters->hits + guardMemo.counters->misses, 0);
+  guardMemo.capacity = 1024;
+  feed<SharedMonitor>(DataParametricCopy().automaton, makeTimedWord(), 1, {}, guardMemo);
+  BOOST_TEST(guardMemo.counters->hits > 0);
+  checkSameResults(resultVec, expected, &DataParametricMonitorResult::numberValuation);
+}
+
+// The configuration with n0 == 5 is pruned after the first event because the one with no constraint on n0 contains it.
+// Both of their matches at the first event are printed, but only the latter makes a match at the second event.
+BOOST_FIXTURE_TEST_CASE(subsumedConfiguration, DataParametricMonitorFixture)
+{
+  using namespace Parma_Polyhedra_Library;
+  DataParametricTA automaton;
+  automaton.states = {std::make_shared<DataParametricTAState>(false), std::make_shared<DataParametricTAState>(true),
+                      std::make_shared<DataParametricTAState>(true)};
+  automaton.initialStates = {automaton.states[0]};
+  automaton.clockVariableSize = 1;
+  automaton.stringVariableSize = 0;
+  automaton.numberVariableSize = 1;
+  Symbolic::Update update;
+  update.numberUpdate.emplace_back(VariableID{0}, Variable(1));
+  automaton.states[0]->next[0] = {{{}, {}, {}, {}, {}, automaton.states[1]},
+                                  {{}, {}, std::move(update), {}, {}, automaton.states[1]}};
+  automaton.states[1]->next[1] = {{{}, {}, {}, {}, {}, automaton.states[2]}};
+
+  feed(automaton, {{0, {}, {5}, 1}, {1, {}, {7}, 2}});
+  BOOST_REQUIRE_EQUAL(resultVec.size(), 3);
+  BOOST_CHECK_EQUAL(resultVec[0].index, 0);
+  BOOST_CHECK_EQUAL(resultVec[1].index, 0);
+  BOOST_TEST((resultVec[0].numberValuation.contains(resultVec[1].numberValuation) ||
+              resultVec[1].numberValuation.contains(resultVec[0].numberValuation)));
+  BOOST_CHECK_EQUAL(resultVec[2].index, 1);
+  BOOST_TEST((resultVec[2].numberValuation == Symbolic::NumberValuation(1)));
+}
+
+// The two configurations after the first event differ only in the number valuation, and the budget merges them.
+BOOST_FIXTURE_TEST_CASE(merge, DataParametricMonitorFixture)
+{
+  using namespace Parma_Polyhedra_Library;
+  DataParametricTA automaton;
+  automaton.states = {std::make_shared<DataParametricTAState>(false), std::make_shared<DataParametricTAState>(false),
+                      std::make_shared<DataParametricTAState>(true)};
+  automaton.initialStates = {automaton.states[0]};
+  automaton.clockVariableSize = 1;
+  automaton.stringVariableSize = 0;
+  automaton.numberVariableSize = 1;
+  Symbolic::Update update;
+  update.numberUpdate.emplace_back(VariableID{0}, Variable(1));
+  automaton.states[0]->next[0] = {{{}, {}, std::move(update), {}, {}, automaton.states[1]},
+                                  {{}, {Variable(0) < Variable(1)}, {}, {}, {}, automaton.states[1]}};
+  automaton.states[1]->next[1] = {{{}, {}, {}, {}, {}, automaton.states[2]}};
+  const auto makeTimedWord = [] { return std::vector<TWEvent>{{0, {}, {5}, 1}, {1, {}, {0}, 2}}; };
+
+  feed(automaton, makeTimedWord());
+  BOOST_CHECK_EQUAL(resultVec.size(), 2);
+
+  const MonitorBudget budget{1, 0, BudgetPolicy::Merge, std::make_shared<BudgetCounters>()};
+  feed(automaton, makeTimedWord(), 1, budget);
+  BOOST_CHECK_EQUAL(budget.counters->exceeded, 1);
+  BOOST_CHECK_EQUAL(budget.counters->merged, 1);
+  BOOST_REQUIRE_EQUAL(resultVec.size(), 1);
+  BOOST_CHECK_EQUAL(resultVec.front().index, 1);
+  Symbolic::NumberValuation hull(1);
+  hull.add_constraint(Variable(0) <= 5);
+  BOOST_TEST((resultVec.front().numberValuation == hull));
+
+  // The merged configuration still exceeds the budget.
+  BOOST_CHECK_THROW(feed(automaton, makeTimedWord(), 1, MonitorBudget{0, 1, BudgetPolicy::Merge}),
+                    std::runtime_error);
+}
+
 BOOST_FIXTURE_TEST_CASE(epsilon_test1, DataParametricMonitorFixture)
 {
   auto automaton = EpsilonTransitionAutomatonFixture::FIXTURE1.makeDataParametricTA();
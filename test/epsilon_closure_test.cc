@@ -0,0 +1,69 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <vector>
+#include "../src/epsilon_closure.hh"
+#include "../src/automaton.hh"
+
+BOOST_AUTO_TEST_SUITE(EpsilonClosureTest)
+
+using State = NonParametricTAState<int>;
+constexpr Action unobservable = 127;
+
+NonParametricTA<int> makeAutomaton() {
+  NonParametricTA<int> automaton;
+  automaton.states = {std::make_shared<State>(false), std::make_shared<State>(false), std::make_shared<State>(true)};
+  automaton.initialStates = {automaton.states[0]};
+  automaton.clockVariableSize = 2;
+  automaton.stringVariableSize = 0;
+  automaton.numberVariableSize = 0;
+  return automaton;
+}
+
+BOOST_AUTO_TEST_CASE(normalize) {
+  auto automaton = makeAutomaton();
+  automaton.states[0]->next[0] = {{{}, {}, {}, {}, {}, automaton.states[1]}};
+  automaton.states[0]->next[unobservable] = {
+      // The duplicated equality is removed, and the equalities are sorted by the clock.
+      {{}, {}, {}, {}, {ConstraintMaker(1) == 2, ConstraintMaker(0) == 1, ConstraintMaker(1) == 2},
+       automaton.states[1]},
+      // The contradicting equalities are never satisfied.
+      {{}, {}, {}, {}, {ConstraintMaker(0) == 1, ConstraintMaker(0) == 2}, automaton.states[2]}};
+  automaton.states[1]->next[unobservable] = {{{}, {}, {}, {}, {}, automaton.states[2]}};
+  const CompiledAutomaton<State> compiled(automaton);
+  const EpsilonClosure<State> closure(compiled, unobservable);
+  BOOST_TEST(!closure.empty());
+
+  std::vector<const EpsilonClosure<State>::DelayedEdge *> edges;
+  for (const auto &edge: closure.edges(0)) {
+    edges.push_back(&edge);
+  }
+  BOOST_REQUIRE_EQUAL(edges.size(), 1);
+  BOOST_CHECK_EQUAL(edges[0]->edge->target, 1);
+  BOOST_REQUIRE_EQUAL(edges[0]->equalities.size(), 2);
+  BOOST_CHECK_EQUAL(edges[0]->equalities[0].x, 0);
+  BOOST_CHECK_EQUAL(edges[0]->equalities[0].c, 1);
+  BOOST_CHECK_EQUAL(edges[0]->equalities[1].x, 1);
+  BOOST_CHECK_EQUAL(edges[0]->equalities[1].c, 2);
+
+  const auto fromOne = closure.edges(1);
+  BOOST_REQUIRE_EQUAL(fromOne.end() - fromOne.begin(), 1);
+  BOOST_CHECK_EQUAL(fromOne.begin()->edge->target, 2);
+  BOOST_TEST(fromOne.begin()->equalities.empty());
+  BOOST_TEST((closure.edges(2).begin() == closure.edges(2).end()));
+}
+
+BOOST_AUTO_TEST_CASE(noUnobservable) {
+  auto automaton = makeAutomaton();
+  automaton.states[0]->next[0] = {{{}, {}, {}, {}, {ConstraintMaker(0) < 1}, automaton.states[2]}};
+  const CompiledAutomaton<State> compiled(automaton);
+  BOOST_TEST(EpsilonClosure<State>(compiled, unobservable).empty());
+}
+
+BOOST_AUTO_TEST_CASE(inequality) {
+  auto automaton = makeAutomaton();
+  automaton.states[0]->next[unobservable] = {{{}, {}, {}, {}, {ConstraintMaker(0) < 1}, automaton.states[2]}};
+  const CompiledAutomaton<State> compiled(automaton);
+  BOOST_CHECK_THROW(EpsilonClosure<State>(compiled, unobservable), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
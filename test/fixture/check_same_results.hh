@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+/*
+  @brief Check that a variant of a monitor, e.g., in parallel, reports the same matches in the same order as the
+  reference.
+
+  @param valuations The pointers to the members of the results compared in addition to the index and the timestamp
+*/
+template <typename Result, typename... Valuations>
+void checkSameResults(const std::vector<Result> &results, const std::vector<Result> &expected,
+                      Valuations... valuations) {
+    BOOST_REQUIRE_EQUAL(results.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        BOOST_CHECK_EQUAL(results[i].index, expected[i].index);
+        BOOST_CHECK_EQUAL(results[i].timestamp, expected[i].timestamp);
+        ([&](auto valuation) { BOOST_TEST((results[i].*valuation == expected[i].*valuation)); }(valuations), ...);
+    }
+}
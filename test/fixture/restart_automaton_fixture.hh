@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "automaton.hh"
+#include "timing_constraint.hh"
+
+/*
+  @brief This automaton starts a partial match at every event by resetting the clock, and the partial match reaches
+  the accepting state by an event satisfying the given timing guard.
+*/
+struct RestartFixture {
+    explicit RestartFixture(std::vector<TimingConstraint> guard) {
+        automaton.states = {std::make_shared<NonParametricTAState<int>>(false),
+                            std::make_shared<NonParametricTAState<int>>(false),
+                            std::make_shared<NonParametricTAState<int>>(true)};
+        automaton.initialStates = {automaton.states[0]};
+        automaton.clockVariableSize = 1;
+        automaton.stringVariableSize = 0;
+        automaton.numberVariableSize = 0;
+        automaton.states[0]->next[0] = {{{}, {}, {}, {}, {}, automaton.states[0]},
+                                        {{}, {}, {}, {VariableID{0}}, {}, automaton.states[1]}};
+        automaton.states[1]->next[0] = {{{}, {}, {}, {}, {}, automaton.states[1]},
+                                        {{}, {}, {}, {}, std::move(guard), automaton.states[2]}};
+    }
+
+    NonParametricTA<int> automaton;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*
+  @brief The timed words of the action 0 with an event at every interval
+*/
+namespace TimedWordFixture {
+    //! @brief The events have no data.
+    template <typename Event> std::vector<Event> makePeriodic(std::size_t size, double interval) {
+        std::vector<Event> timedWord;
+        timedWord.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            timedWord.push_back({0, {}, {}, interval * i});
+        }
+        return timedWord;
+    }
+
+    //! @brief The events have the strings "y" and "x" alternately and the given numbers.
+    template <typename Event>
+    std::vector<Event> makeAlternating(std::size_t size, double interval, const decltype(Event::numbers) &numbers) {
+        std::vector<Event> timedWord;
+        timedWord.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            timedWord.push_back({0, {i % 2 ? "x" : "y"}, numbers, interval * i});
+        }
+        return timedWord;
+    }
+}
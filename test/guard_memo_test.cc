@@ -0,0 +1,93 @@
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include "../src/guard_memo.hh"
+
+BOOST_AUTO_TEST_SUITE(GuardMemoTest)
+
+//! @brief A one-dimensional polyhedron [lower, upper]
+struct Interval {
+  int lower, upper;
+
+  bool operator==(const Interval &other) const {
+    return lower == other.lower && upper == other.upper;
+  }
+};
+
+//! @brief The intervals with the same lower bound collide.
+std::size_t fingerprint(const Interval &interval) {
+  return interval.lower;
+}
+
+//! @brief Intersect the interval with [lower, +inf) counting the calls.
+struct LowerGuard {
+  int lower;
+  int &calls;
+
+  bool operator()(Interval &interval) const {
+    ++calls;
+    interval.lower = std::max(interval.lower, lower);
+    return interval.lower <= interval.upper;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(memoize) {
+  GuardMemo<Interval> memo;
+  int calls = 0;
+  Interval interval{0, 10};
+  BOOST_TEST(memo.apply(interval, 0, LowerGuard{5, calls}));
+  BOOST_TEST((interval == Interval{5, 10}));
+
+  interval = {0, 10};
+  BOOST_TEST(memo.apply(interval, 0, LowerGuard{5, calls}));
+  BOOST_TEST((interval == Interval{5, 10}));
+  BOOST_TEST(calls == 1);
+
+  // The results are keyed by the transition, too.
+  interval = {0, 10};
+  BOOST_TEST(!memo.apply(interval, 1, LowerGuard{20, calls}));
+  interval = {0, 10};
+  BOOST_TEST(!memo.apply(interval, 1, LowerGuard{20, calls}));
+  BOOST_TEST(calls == 2);
+  BOOST_TEST(memo.getCounters().hits == 2);
+  BOOST_TEST(memo.getCounters().misses == 2);
+}
+
+BOOST_AUTO_TEST_CASE(collision) {
+  GuardMemo<Interval> memo;
+  int calls = 0;
+  Interval interval{0, 10};
+  BOOST_TEST(memo.apply(interval, 0, LowerGuard{5, calls}));
+  // The same fingerprint but a different interval is a miss, which replaces the memoized result.
+  interval = {0, 3};
+  BOOST_TEST(!memo.apply(interval, 0, LowerGuard{5, calls}));
+  BOOST_TEST(calls == 2);
+  BOOST_TEST(memo.size() == 1);
+  BOOST_TEST(memo.getCounters().hits == 0);
+}
+
+BOOST_AUTO_TEST_CASE(leastRecentlyUsed) {
+  GuardMemo<Interval> memo(2);
+  int calls = 0;
+  for (int lower: {0, 1, 0, 2, 0, 1}) {
+    Interval interval{lower, 10};
+    memo.apply(interval, 0, LowerGuard{5, calls});
+  }
+  // [1, 10] is evicted by [2, 10] because [0, 10] is used more recently.
+  BOOST_TEST(memo.size() == 2);
+  BOOST_TEST(memo.getCounters().hits == 2);
+  BOOST_TEST(memo.getCounters().misses == 4);
+}
+
+BOOST_AUTO_TEST_CASE(disabled) {
+  GuardMemo<Interval> memo(0);
+  int calls = 0;
+  for (int i = 0; i < 2; ++i) {
+    Interval interval{0, 10};
+    BOOST_TEST(memo.apply(interval, 0, LowerGuard{5, calls}));
+    BOOST_TEST((interval == Interval{5, 10}));
+  }
+  BOOST_TEST(calls == 2);
+  BOOST_TEST(memo.size() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,105 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+#include "../src/mmap_timed_word_parser.hh"
+
+BOOST_AUTO_TEST_SUITE(MmapTimedWordParserTest)
+
+struct MmapWithdrawWordFixture {
+  MmapWithdrawWordFixture() {
+    sigStream << "withdraw\t1\t1" << "\n";
+    word = "withdraw\tAlice\t6000\t10\n"
+           "withdraw\tBob\t300\t20\n"
+           "deposit\tCharlie\t100\t20\n"
+           "withdraw\tDan\t300\t20\n"
+           "withdraw\tCharlie\t2000\t20.5\n"
+           "withdraw\tAlice\t6000\t30\n"
+           "withdraw\tCharlie\t9000\t60";
+  }
+  ~MmapWithdrawWordFixture() {
+    if (!fileName.empty()) {
+      std::remove(fileName.c_str());
+    }
+  }
+
+  //! @brief Write the timed word to a temporary file and return its name
+  const std::string &writeFile() {
+    char name[] = "/tmp/symon_mmap_testXXXXXX";
+    const int fd = mkstemp(name);
+    BOOST_REQUIRE(fd >= 0);
+    BOOST_REQUIRE_EQUAL(write(fd, word.data(), word.size()), static_cast<ssize_t>(word.size()));
+    close(fd);
+    fileName = name;
+    return fileName;
+  }
+
+  void execute(AbstractTimedWordParser<int> &parser) {
+    const std::vector<TimedWordEvent<int>> expectedEvents = {{0, {"Alice"}, {6000}, 10},  {0, {"Bob"}, {300}, 20},
+                                                             {0, {"Dan"}, {300}, 20},     {0, {"Charlie"}, {2000}, 20.5},
+                                                             {0, {"Alice"}, {6000}, 30}, {0, {"Charlie"}, {9000}, 60}};
+
+    TimedWordEvent<int> event;
+
+    for (const auto &expectedEvent: expectedEvents) {
+      BOOST_TEST(parser.parse(event));
+      BOOST_CHECK_EQUAL(event.actionId, expectedEvent.actionId);
+      BOOST_CHECK_EQUAL(event.strings.size(), expectedEvent.strings.size());
+      BOOST_CHECK_EQUAL(event.strings.front(), expectedEvent.strings.front());
+      BOOST_CHECK_EQUAL(event.numbers.size(), expectedEvent.numbers.size());
+      BOOST_CHECK_EQUAL(event.numbers.front(), expectedEvent.numbers.front());
+      BOOST_CHECK_EQUAL(event.timestamp, expectedEvent.timestamp);
+    }
+    BOOST_TEST(!parser.parse(event));
+  }
+
+  std::stringstream sigStream;
+  std::string word;
+  std::string fileName;
+};
+
+BOOST_FIXTURE_TEST_CASE(mappedFile, MmapWithdrawWordFixture) {
+  Signature sig(sigStream);
+  MmapTimedWordParser<int> parser{writeFile(), sig};
+  execute(parser);
+}
+
+BOOST_FIXTURE_TEST_CASE(bufferedRead, MmapWithdrawWordFixture) {
+  Signature sig(sigStream);
+  const int fd = open(writeFile().c_str(), O_RDONLY);
+  BOOST_REQUIRE(fd >= 0);
+  {
+    MmapTimedWordParser<int> parser{fd, sig};
+    execute(parser);
+  }
+  close(fd);
+}
+
+// The tokens cross the boundary of the buffer and some are longer than the buffer.
+BOOST_FIXTURE_TEST_CASE(bufferedReadSmallBuffer, MmapWithdrawWordFixture) {
+  Signature sig(sigStream);
+  const int fd = open(writeFile().c_str(), O_RDONLY);
+  BOOST_REQUIRE(fd >= 0);
+  {
+    MmapTimedWordParser<int> parser{fd, sig, 3};
+    execute(parser);
+  }
+  close(fd);
+}
+
+BOOST_FIXTURE_TEST_CASE(emptyFile, MmapWithdrawWordFixture) {
+  word.clear();
+  Signature sig(sigStream);
+  MmapTimedWordParser<int> parser{writeFile(), sig};
+  TimedWordEvent<int> event;
+  BOOST_TEST(!parser.parse(event));
+}
+
+BOOST_AUTO_TEST_CASE(missingFile) {
+  std::stringstream sigStream;
+  sigStream << "withdraw\t1\t1";
+  Signature sig(sigStream);
+  BOOST_CHECK_THROW((MmapTimedWordParser<int>{"/nonexistent/symon/timed_word", sig}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+#include "../src/non_symbolic_number_program.hh"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <optional>
+
+BOOST_AUTO_TEST_SUITE(NonSymbolicNumberProgramTests)
+  using Expr = NonSymbolic::NumberExpression<int>;
+  using Constraint = NonSymbolic::NumberConstraint<int>;
+  using Program = NonSymbolic::NumberProgram<int>;
+  using Updates = std::vector<std::pair<VariableID, Expr>>;
+
+  Expr plus(Expr left, Expr right) {
+    return {NonSymbolic::NumberExpressionKind::PLUS, std::make_shared<Expr>(left), std::make_shared<Expr>(right)};
+  }
+
+  Expr minus(Expr left, Expr right) {
+    return {NonSymbolic::NumberExpressionKind::MINUS, std::make_shared<Expr>(left), std::make_shared<Expr>(right)};
+  }
+
+  BOOST_AUTO_TEST_CASE(guard) {
+    // x0 + 3 > x1 - x2 && x0 != 1
+    const Program program({Constraint{NonSymbolic::NumberComparatorKind::GT,
+                                      {plus(Expr(0), Expr::constant(3)), minus(Expr(1), Expr(2))}},
+                           Constraint{NonSymbolic::NumberComparatorKind::NE, {Expr(0), Expr::constant(1)}}},
+                          {});
+    BOOST_TEST(program.guard({2, 10, 6}));
+    BOOST_TEST(!program.guard({2, 10, 5}));
+    BOOST_TEST(!program.guard({1, 10, 6}));
+    // A comparison with an undefined value does not hold
+    BOOST_TEST(!program.guard({2, std::nullopt, 6}));
+  }
+
+  BOOST_AUTO_TEST_CASE(emptyGuard) {
+    const Program program;
+    BOOST_TEST(program.guard({}));
+  }
+
+  BOOST_AUTO_TEST_CASE(deepExpression) {
+    // ((((x0 + 1) + 1) ... ) + 1) == 20 is evaluated in the inline stack, and 1 + (1 + (... + x0)) == 20 is not.
+    Expr left = Expr(0), right = Expr(0);
+    for (int i = 0; i < 20; i++) {
+      left = plus(left, Expr::constant(1));
+      right = plus(Expr::constant(1), right);
+    }
+    const Program program({Constraint{NonSymbolic::NumberComparatorKind::EQ, {left, Expr::constant(20)}},
+                           Constraint{NonSymbolic::NumberComparatorKind::EQ, {right, Expr::constant(20)}}},
+                          {});
+    BOOST_TEST(program.guard({0}));
+    BOOST_TEST(!program.guard({1}));
+  }
+
+  BOOST_AUTO_TEST_CASE(update) {
+    // x0 := x1, x1 := 5, x2 := x0 + 10, x3 := x4 - 1, in order
+    const Program program({}, Updates{{0, Expr(1)},
+                                      {1, Expr::constant(5)},
+                                      {2, plus(Expr(0), Expr::constant(10))},
+                                      {3, minus(Expr(4), Expr::constant(1))}});
+    NonSymbolic::NumberValuation<int> env = {1, 2, 4, 8, std::nullopt};
+    program.update(env);
+    BOOST_CHECK_EQUAL(env[0].value(), 2);
+    BOOST_CHECK_EQUAL(env[1].value(), 5);
+    BOOST_CHECK_EQUAL(env[2].value(), 12);
+    BOOST_TEST(!env[3].has_value());
+    BOOST_TEST(!env[4].has_value());
+  }
+
+  BOOST_AUTO_TEST_CASE(guardAndUpdate) {
+    const Program program({Constraint{NonSymbolic::NumberComparatorKind::LT, {Expr(0), Expr::constant(3)}}},
+                          Updates{{0, plus(Expr(0), Expr::constant(1))}});
+    NonSymbolic::NumberValuation<int> env = {1};
+    BOOST_TEST(program.guard(env));
+    program.update(env);
+    BOOST_CHECK_EQUAL(env[0].value(), 2);
+  }
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,61 @@
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include "../src/output_buffer.hh"
+
+BOOST_AUTO_TEST_SUITE(OutputBufferTest)
+
+// The numbers are formatted in the same way as std::ostream.
+BOOST_AUTO_TEST_CASE(sameAsStream) {
+  std::vector<double> values = {0.0,
+                                -0.0,
+                                1.0,
+                                -2.5,
+                                0.1,
+                                1e-7,
+                                123456.5,
+                                1234567.0,
+                                1e21,
+                                9.9999995,
+                                std::numeric_limits<double>::max(),
+                                std::numeric_limits<double>::denorm_min(),
+                                std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity()};
+  std::mt19937 engine(1);
+  std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(distribution(engine));
+    values.push_back(std::ldexp(distribution(engine), i % 200 - 100));
+  }
+  std::ostringstream expected, actual;
+  {
+    OutputBuffer out(actual, 0);
+    for (const double value: values) {
+      expected << std::fixed << value << std::defaultfloat << '\t' << value << '\t' << static_cast<long>(value) << '\n';
+      out.writeFixed(value).put('\t').writeNumber(value).put('\t').writeInteger(static_cast<long>(value)).put('\n');
+    }
+  }
+  BOOST_CHECK_EQUAL(actual.str(), expected.str());
+}
+
+BOOST_AUTO_TEST_CASE(flushPoints) {
+  std::ostringstream sink;
+  OutputBuffer out(sink);
+  out.write("x").put('0').write(" == ");
+  out.stream() << std::setw(3) << std::setfill('0') << 7;
+  BOOST_TEST(sink.str().empty());
+  out.drain();
+  BOOST_CHECK_EQUAL(sink.str(), "x0 == 007");
+
+  // A string longer than the buffer is written directly.
+  const std::string large(5000, 'a');
+  OutputBuffer small(sink, 0);
+  small.put('b').write(large);
+  BOOST_CHECK_EQUAL(sink.str(), "x0 == 007b" + large);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+#include <boost/test/unit_test.hpp>
+#include "../src/parametric_dbm.hh"
+
+BOOST_AUTO_TEST_SUITE(ParametricDBMTest)
+
+using Difference = ParametricDBM::Difference;
+
+BOOST_AUTO_TEST_CASE(elapseAndReset) {
+  // x_1 is the parameter p, and x_2 and x_3 are the clocks.
+  ParametricDBM pdbm(1, 2);
+  BOOST_CHECK_EQUAL(pdbm.dimension(), 3);
+  pdbm.elapse(PPLRational(3, 2));
+  pdbm.reset(1);
+  pdbm.elapse(2);
+  // x0 == 3.5, x1 == 2, and p >= 0
+  BOOST_CHECK_EQUAL(pdbm.at(2, 0).value, PPLRational(7, 2));
+  BOOST_CHECK_EQUAL(pdbm.at(0, 2).value, PPLRational(-7, 2));
+  BOOST_CHECK_EQUAL(pdbm.at(3, 0).value, 2);
+  BOOST_CHECK_EQUAL(pdbm.at(2, 3).value, PPLRational(3, 2));
+  // x0 - p <= 3.5, and p - x0 is unbounded
+  BOOST_CHECK_EQUAL(pdbm.at(2, 1).value, PPLRational(7, 2));
+  BOOST_TEST(pdbm.at(1, 2).infinite);
+  BOOST_CHECK_EQUAL(pdbm.at(0, 1).value, 0);
+}
+
+BOOST_AUTO_TEST_CASE(constrain) {
+  ParametricDBM pdbm(1, 1);
+  pdbm.elapse(2);
+  // x - p < 0, i.e., p > 2
+  BOOST_TEST(pdbm.constrain(Difference{2, 1, {0, true}}));
+  BOOST_CHECK_EQUAL(pdbm.at(0, 1).value, -2);
+  BOOST_TEST(pdbm.at(0, 1).strict);
+  ParametricDBM copy = pdbm;
+  // p <= 5 does not make it empty
+  BOOST_TEST(copy.constrain(Difference{1, 0, {5, false}}));
+  BOOST_TEST(pdbm.contains(copy));
+  BOOST_TEST(!copy.contains(pdbm));
+  // p <= 2 makes it empty
+  BOOST_TEST(!pdbm.constrain(Difference{1, 0, {2, false}}));
+}
+
+BOOST_AUTO_TEST_CASE(extendedClock) {
+  ParametricDBM pdbm(0, 1);
+  pdbm.elapse(1);
+  // The clock t for the time elapse since the previous event
+  pdbm.addClock();
+  pdbm.elapse();
+  // t <= 3 and x >= 2
+  BOOST_TEST(pdbm.constrain(Difference{2, 0, {3, false}}));
+  BOOST_TEST(pdbm.constrain(Difference{0, 1, {-2, false}}));
+  BOOST_CHECK_EQUAL(pdbm.at(0, 2).value, -1);
+  pdbm.reset(0);
+  // Let the time elapse until t == 3
+  pdbm.elapse();
+  BOOST_TEST(pdbm.constrain(ParametricDBM::Guard{Difference{2, 0, {3, false}}, Difference{0, 2, {-3, false}}}));
+  pdbm.removeClock();
+  BOOST_CHECK_EQUAL(pdbm.dimension(), 1);
+  // 0 <= x <= 2
+  BOOST_CHECK_EQUAL(pdbm.at(1, 0).value, 2);
+  BOOST_CHECK_EQUAL(pdbm.at(0, 1).value, 0);
+
+  ParametricDBM other(0, 1);
+  other.elapse(3);
+  BOOST_TEST((pdbm != other));
+  BOOST_TEST((ParametricDBM(1, 1) == ParametricDBM(1, 1)));
+  BOOST_CHECK_EQUAL(hash_value(ParametricDBM(1, 1)), hash_value(ParametricDBM(1, 1)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,9 +5,11 @@
 
 #include "../src/parametric_monitor.hh"
 #include "../test/fixture/non_integer_timestamp_fixture.hh"
+#include "../test/fixture/check_same_results.hh"
 #include "ppl_rational.hh"
 #include "symbolic_string_constraint.hh"
 #include <ppl.hh>
+#include <algorithm>
 #include <sstream>
 
 namespace Parma_Polyhedra_Library {
@@ -50,8 +52,9 @@ struct DummyParametricMonitorObserver : public Observer<ParametricMonitorResult>
 };
 
 struct ParametricMonitorFixture {
-  void feed(ParametricTA automaton, std::vector<TWEvent> &&vec) {
-    auto monitor = std::make_shared<ParametricMonitor>(automaton);
+  template <typename Monitor = ParametricMonitor>
+  void feed(ParametricTA automaton, std::vector<TWEvent> &&vec, std::size_t threads = 1, MonitorBudget budget = {}) {
+    auto monitor = std::make_shared<Monitor>(automaton, threads, std::move(budget));
     auto observer = std::make_shared<DummyParametricMonitorObserver>();
     monitor->addObserver(observer);
     DummyParametricTimedWordSubject subject{std::move(vec)};
@@ -158,7 +161,7 @@ BOOST_AUTO_TEST_SUITE(ParametricMonitorTest)
 
     BOOST_CHECK_EQUAL(1, resultVec.at(0).stringValuation.size());
     BOOST_CHECK_EQUAL(1, resultVec.at(0).stringValuation.at(0).index());
-    BOOST_CHECK_EQUAL("foo", std::get<std::string>(resultVec.at(0).stringValuation.at(0)));
+    BOOST_CHECK_EQUAL("foo", std::get<InternedString>(resultVec.at(0).stringValuation.at(0)));
   }
 
   BOOST_FIXTURE_TEST_CASE(non_integer_timestamp_test, ParametricMonitorFixture) {
@@ -181,5 +184,158 @@ BOOST_AUTO_TEST_SUITE(ParametricMonitorTest)
       BOOST_CHECK_EQUAL(resultVec[1].timestamp, t1);
   }
 
+  // The worker threads use their own copies of the guards, and the results are the same as the single thread. More
+  // than one thread needs PPL built with thread safety.
+  BOOST_FIXTURE_TEST_CASE(parallel, ParametricMonitorFixture) {
+    const auto makeTimedWord = [] {
+      std::vector<TWEvent> timedWord;
+      for (int i = 1; i <= 50; ++i) {
+        timedWord.push_back({0, {}, {0}, {i * 105, 100}});
+      }
+      return timedWord;
+    };
+    feed(Parametric::ParametricNonIntegerTimestampFixture().automaton, makeTimedWord());
+    const auto expected = std::move(resultVec);
+    BOOST_REQUIRE(!expected.empty());
+    if (!ParametricMonitor::isThreadSafe) {
+      BOOST_CHECK_THROW(feed(Parametric::ParametricNonIntegerTimestampFixture().automaton, makeTimedWord(), 4),
+                        std::runtime_error);
+      return;
+    }
+    feed(Parametric::ParametricNonIntegerTimestampFixture().automaton, makeTimedWord(), 4);
+    checkSameResults(resultVec, expected, &ParametricMonitorResult::parametricTimingValuation);
+  }
+
+  BOOST_FIXTURE_TEST_CASE(dbm, ParametricMonitorFixture) {
+    ParametricTA automaton;
+    automaton.clockVariableSize = 1;
+    automaton.parameterSize = 1;
+    automaton.stringVariableSize = 0;
+    automaton.numberVariableSize = 0;
+    automaton.states.resize(2);
+    automaton.states[0] = std::make_shared<PTAState>(false);
+    automaton.states[1] = std::make_shared<PTAState>(true);
+    automaton.initialStates = {automaton.states[0]};
+
+    using namespace Parma_Polyhedra_Library;
+    // p is Variable(0) and x is Variable(1)
+    automaton.states[0]->next[0].resize(2);
+    automaton.states[0]->next[0].at(0).guard = NNC_Polyhedron(2);
+    automaton.states[0]->next[0].at(0).resetVars = {0};
+    automaton.states[0]->next[0].at(0).target = automaton.states[0];
+    // 1 < x < p
+    automaton.states[0]->next[0].at(1).guard = NNC_Polyhedron(2);
+    automaton.states[0]->next[0].at(1).guard.add_constraint(Variable(1) > 1);
+    automaton.states[0]->next[0].at(1).guard.add_constraint(Variable(1) - Variable(0) < 0);
+    automaton.states[0]->next[0].at(1).target = automaton.states[1];
+    // x - p >= 2
+    automaton.states[1]->next[0].resize(1);
+    automaton.states[1]->next[0].at(0).guard = NNC_Polyhedron(2);
+    automaton.states[1]->next[0].at(0).guard.add_constraint(Variable(1) - Variable(0) >= 2);
+    automaton.states[1]->next[0].at(0).target = automaton.states[1];
+    BOOST_REQUIRE(BasicParametricMonitor<ParametricDBMDomain>::supports(automaton));
+
+    const auto makeTimedWord = [] {
+      return std::vector<TWEvent>{{0, {}, {}, 1}, {0, {}, {}, {5, 2}}, {0, {}, {}, 3}, {0, {}, {}, {9, 2}},
+                                  {0, {}, {}, 6}, {0, {}, {}, 10}};
+    };
+    feed(automaton, makeTimedWord());
+    const auto expected = std::move(resultVec);
+    BOOST_REQUIRE(!expected.empty());
+    feed<BasicParametricMonitor<ParametricDBMDomain>>(automaton, makeTimedWord());
+    // The order of the matches at the same event depends on the representation.
+    BOOST_REQUIRE_EQUAL(resultVec.size(), expected.size());
+    for (const auto &result: resultVec) {
+      const auto sameMatch = [&result](const ParametricMonitorResult &other) {
+        return result.index == other.index && result.parametricTimingValuation == other.parametricTimingValuation;
+      };
+      BOOST_CHECK_EQUAL(std::count_if(resultVec.begin(), resultVec.end(), sameMatch),
+                        std::count_if(expected.begin(), expected.end(), sameMatch));
+    }
+
+    // x + p < 3 is not a bound of a difference.
+    automaton.states[1]->next[0].at(0).guard.add_constraint(Variable(1) + Variable(0) < 3);
+    BOOST_TEST(!BasicParametricMonitor<ParametricDBMDomain>::supports(automaton));
+  }
+
+  // The two configurations after the first event differ only in the number valuation, and the budget merges them.
+  BOOST_FIXTURE_TEST_CASE(merge, ParametricMonitorFixture) {
+    ParametricTA automaton;
+    automaton.clockVariableSize = 0;
+    automaton.parameterSize = 0;
+    automaton.stringVariableSize = 0;
+    automaton.numberVariableSize = 1;
+    automaton.states = {std::make_shared<PTAState>(false), std::make_shared<PTAState>(false),
+                        std::make_shared<PTAState>(true)};
+    automaton.initialStates = {automaton.states[0]};
+
+    using namespace Parma_Polyhedra_Library;
+    automaton.states[0]->next[0].resize(2);
+    automaton.states[0]->next[0].at(0).numConstraints.emplace_back(Variable(0) == Variable(1));
+    automaton.states[0]->next[0].at(0).target = automaton.states[1];
+    automaton.states[0]->next[0].at(1).numConstraints.emplace_back(Variable(0) < Variable(1));
+    automaton.states[0]->next[0].at(1).target = automaton.states[1];
+    automaton.states[1]->next[1].resize(1);
+    automaton.states[1]->next[1].at(0).target = automaton.states[2];
+
+    const auto makeTimedWord = [] { return std::vector<TWEvent>{{0, {}, {5}, 1}, {1, {}, {0}, 2}}; };
+    feed(automaton, makeTimedWord());
+    BOOST_CHECK_EQUAL(resultVec.size(), 2);
+
+    const MonitorBudget budget{1, 0, BudgetPolicy::Merge, std::make_shared<BudgetCounters>()};
+    feed(automaton, makeTimedWord(), 1, budget);
+    BOOST_CHECK_EQUAL(budget.counters->exceeded, 1);
+    BOOST_CHECK_EQUAL(budget.counters->merged, 1);
+    BOOST_REQUIRE_EQUAL(resultVec.size(), 1);
+    BOOST_CHECK_EQUAL(resultVec.front().index, 1);
+    NNC_Polyhedron hull(1);
+    hull.add_constraint(Variable(0) <= 5);
+    BOOST_TEST((resultVec.front().numberValuation == hull));
+
+    // The merged configuration still exceeds the budget.
+    BOOST_CHECK_THROW(feed(automaton, makeTimedWord(), 1, MonitorBudget{0, 1, BudgetPolicy::Merge}),
+                      std::runtime_error);
+  }
+
+  // The result of a guard on a valuation equal to a previous one is memoized.
+  BOOST_AUTO_TEST_CASE(guardMemo) {
+    ParametricTA automaton;
+    automaton.clockVariableSize = 1;
+    automaton.parameterSize = 1;
+    automaton.stringVariableSize = 0;
+    automaton.numberVariableSize = 0;
+    automaton.states = {std::make_shared<PTAState>(false), std::make_shared<PTAState>(true)};
+    automaton.initialStates = {automaton.states[0]};
+
+    using namespace Parma_Polyhedra_Library;
+    // x < p
+    automaton.states[0]->next[0].resize(1);
+    automaton.states[0]->next[0].at(0).guard = NNC_Polyhedron(2);
+    automaton.states[0]->next[0].at(0).guard.add_constraint(Variable(1) - Variable(0) < 0);
+    automaton.states[0]->next[0].at(0).target = automaton.states[1];
+    const CompiledAutomaton<PTAState> compiled(automaton);
+    const ParametricPolyhedronDomain domain(automaton, compiled, 1024);
+
+    auto cval = domain.initial();
+    domain.elapse(cval, 2);
+    const auto elapsed = cval;
+    BOOST_TEST(domain.constrain(cval, 0, false));
+    auto memoized = elapsed;
+    BOOST_TEST(domain.constrain(memoized, 0, false));
+    BOOST_TEST((memoized == cval));
+    BOOST_CHECK_EQUAL(domain.guardMemoCounters().hits, 1);
+    BOOST_CHECK_EQUAL(domain.guardMemoCounters().misses, 1);
+
+    // p == 1 contradicts x < p after the elapse of 2.
+    auto contradicting = elapsed;
+    contradicting.add_constraint(Variable(0) == 1);
+    BOOST_TEST(!domain.constrain(contradicting, 0, false));
+    contradicting = elapsed;
+    contradicting.add_constraint(Variable(0) == 1);
+    BOOST_TEST(!domain.constrain(contradicting, 0, false));
+    BOOST_CHECK_EQUAL(domain.guardMemoCounters().hits, 2);
+    BOOST_CHECK_EQUAL(domain.guardMemoCounters().misses, 2);
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
 
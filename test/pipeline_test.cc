@@ -0,0 +1,57 @@
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include "../src/boolean_monitor.hh"
+#include "../src/pipeline.hh"
+#include "../src/timed_word_subject.hh"
+#include "../test/fixture/copy_automaton_fixture.hh"
+
+BOOST_AUTO_TEST_SUITE(PipelineTest)
+
+struct ResultRecorder : public Observer<BooleanMonitorResult<int>> {
+  void notify(const BooleanMonitorResult<int> &result) override {
+    results.emplace_back(result.index, result.timestamp);
+  }
+  std::vector<std::pair<std::size_t, double>> results;
+};
+
+struct PipelineFixture {
+  PipelineFixture() {
+    sigStream << "update\t1\t1\n";
+    for (int i = 0; i < 2000; ++i) {
+      wordStream << "update\t" << (i % 2 ? "x" : "y") << "\t1\t" << 0.01 * i << "\n";
+    }
+  }
+
+  //! @brief Monitor the timed word with or without the pipeline
+  std::vector<std::pair<std::size_t, double>> run(bool usePipeline) {
+    std::stringstream word{wordStream.str()};
+    std::stringstream sig{sigStream.str()};
+    Signature signature(sig);
+    TimedWordParser<int> parser{word, signature};
+    auto monitor = std::make_shared<NonSymbolic::BooleanMonitor<int>>(CopyFixture().automaton);
+    ResultRecorder recorder;
+    if (usePipeline) {
+      // The small queues make the stages wait for each other.
+      runPipeline(parser, std::move(monitor), recorder, 8, 3);
+    } else {
+      monitor->addObserver(std::shared_ptr<ResultRecorder>(&recorder, [](ResultRecorder *) {}));
+      TimedWordEvent<int> event;
+      while (parser.parse(event)) {
+        monitor->notify(event);
+      }
+    }
+    return recorder.results;
+  }
+
+  std::stringstream sigStream;
+  std::stringstream wordStream;
+};
+
+BOOST_FIXTURE_TEST_CASE(sameAsSequential, PipelineFixture) {
+  const auto expected = run(false);
+  BOOST_REQUIRE(!expected.empty());
+  const auto results = run(true);
+  BOOST_TEST(results == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
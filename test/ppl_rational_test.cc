@@ -160,3 +160,80 @@ BOOST_AUTO_TEST_SUITE(PPLRationalComparisonTests)
     BOOST_CHECK_EQUAL(fourHalves, 2);
   }
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(PPLRationalFromCharsTests)
+
+  BOOST_AUTO_TEST_CASE(parse_negative_decimal) {
+    PPLRational r;
+    BOOST_TEST(fromChars("-1.05", r));
+    BOOST_TEST(r.getNumerator() == -21);
+    BOOST_TEST(r.getDenominator() == 20);
+  }
+
+  BOOST_AUTO_TEST_CASE(parse_leading_dot) {
+    PPLRational r;
+    BOOST_TEST(fromChars(".2", r));
+    BOOST_TEST(r.getNumerator() == 1);
+    BOOST_TEST(r.getDenominator() == 5);
+  }
+
+  BOOST_AUTO_TEST_CASE(reject_invalid_tokens) {
+    PPLRational r;
+    BOOST_TEST(!fromChars("", r));
+    BOOST_TEST(!fromChars("-", r));
+    BOOST_TEST(!fromChars("1.2.3", r));
+    BOOST_TEST(!fromChars("12a", r));
+  }
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(PPLRationalInt64Tests)
+
+  BOOST_AUTO_TEST_CASE(arithmetic_in_int64) {
+    const PPLRational sum = PPLRational(1, 3) + PPLRational(1, 6);
+    BOOST_TEST(sum.isSmall());
+    BOOST_CHECK_EQUAL(sum, PPLRational(1, 2));
+    const PPLRational difference = PPLRational(1500, 1000) - PPLRational(250, 1000);
+    BOOST_TEST(difference.isSmall());
+    BOOST_TEST(difference.getNumerator() == 5);
+    BOOST_TEST(difference.getDenominator() == 4);
+    BOOST_TEST(PPLRational(1, 3) < PPLRational(1, 2));
+    BOOST_TEST(!(PPLRational(1, 2) < PPLRational(-1, 2)));
+  }
+
+  // The results beyond int64 are exact, and they are held as int64 again once they fit.
+  BOOST_AUTO_TEST_CASE(overflow) {
+    const PPLRational max = PPLRational::fromInt64(std::numeric_limits<std::int64_t>::max(), 1);
+    const PPLRational beyond = max + 1;
+    BOOST_TEST(!beyond.isSmall());
+    BOOST_TEST(beyond.getNumerator() ==
+               Parma_Polyhedra_Library::Coefficient(std::numeric_limits<std::int64_t>::max()) + 1);
+    BOOST_TEST(max < beyond);
+    BOOST_TEST(!(max == beyond));
+    const PPLRational back = beyond - 1;
+    BOOST_TEST(back.isSmall());
+    BOOST_CHECK_EQUAL(back, max);
+    BOOST_TEST(hash_value(back) == hash_value(max));
+    BOOST_TEST((-PPLRational::fromInt64(std::numeric_limits<std::int64_t>::min(), 1)).getNumerator() ==
+               -Parma_Polyhedra_Library::Coefficient(std::numeric_limits<std::int64_t>::min()));
+    // The minimum of int64 is held as Coefficient however it is computed, so the equal numbers have the same hash.
+    const PPLRational min = PPLRational::fromInt64(std::numeric_limits<std::int64_t>::min(), 1);
+    const PPLRational computed =
+        PPLRational(Parma_Polyhedra_Library::Coefficient(std::numeric_limits<std::int64_t>::min()) * 3, 3);
+    BOOST_TEST(!min.isSmall());
+    BOOST_TEST(!computed.isSmall());
+    BOOST_CHECK_EQUAL(min, computed);
+    BOOST_TEST(hash_value(min) == hash_value(computed));
+  }
+
+  BOOST_AUTO_TEST_CASE(parse_beyond_int64) {
+    PPLRational r;
+    BOOST_TEST(fromChars("123456789012345678901.5", r));
+    BOOST_TEST(!r.isSmall());
+    BOOST_TEST(r.getDenominator() == 2);
+    PPLRational small;
+    BOOST_TEST(fromChars("1234.567", small));
+    BOOST_TEST(small.isSmall());
+    BOOST_TEST(small.getNumerator() == 1234567);
+    BOOST_TEST(small.getDenominator() == 1000);
+  }
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,4 +21,37 @@ BOOST_AUTO_TEST_CASE(test1)
   BOOST_CHECK_THROW(sig.getNumberSize("type3"), std::out_of_range);
 }
 
+BOOST_AUTO_TEST_CASE(findManyActions)
+{
+  std::stringstream ss;
+  for (std::size_t i = 0; i < 30; i++) {
+    ss << "action" << i << "\t" << i % 3 << "\t" << i % 5 << "\n";
+  }
+  Signature sig(ss);
+
+  BOOST_CHECK_EQUAL(sig.size(), 30u);
+  for (std::size_t i = 0; i < 30; i++) {
+    const std::string name = "action" + std::to_string(i);
+    const Signature::Entry *entry = sig.find(name);
+    BOOST_REQUIRE(entry);
+    BOOST_CHECK_EQUAL(entry->id, i);
+    BOOST_CHECK_EQUAL(entry->stringSize, i % 3);
+    BOOST_CHECK_EQUAL(entry->numberSize, i % 5);
+  }
+  BOOST_TEST(!sig.find("action30"));
+  BOOST_TEST(!sig.find("action"));
+  BOOST_TEST(!sig.find(""));
+}
+
+BOOST_AUTO_TEST_CASE(fromMaps)
+{
+  Signature sig({{"update", 0}, {"withdraw", 1}}, {{"update", 1}, {"withdraw", 2}}, {{"update", 1}, {"withdraw", 0}});
+
+  BOOST_CHECK_EQUAL(sig.getId("withdraw"), 1u);
+  BOOST_CHECK_EQUAL(sig.getStringSize("withdraw"), 2u);
+  BOOST_CHECK_EQUAL(sig.getNumberSize("update"), 1u);
+  BOOST_TEST(!sig.isDefined("deposit"));
+  BOOST_TEST(!Signature().isDefined("update"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,65 @@
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+#include "../src/spsc_queue.hh"
+
+BOOST_AUTO_TEST_SUITE(SpscQueueTest)
+
+BOOST_AUTO_TEST_CASE(capacity) {
+  BOOST_CHECK_EQUAL(SpscQueue<int>{1}.capacity(), 1);
+  BOOST_CHECK_EQUAL(SpscQueue<int>{5}.capacity(), 8);
+  BOOST_CHECK_EQUAL(SpscQueue<int>{8}.capacity(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(wrapAround) {
+  SpscQueue<int> queue{4};
+  int *data;
+  for (int i = 0; i < 3; ++i) {
+    queue.back() = i;
+    queue.push();
+  }
+  BOOST_CHECK_EQUAL(queue.front(data), 3);
+  queue.pop(2);
+  for (int i = 3; i < 6; ++i) {
+    queue.back() = i;
+    queue.push();
+  }
+  // The published slots are 2, 3 at the end of the ring and 4, 5 at the beginning.
+  BOOST_REQUIRE_EQUAL(queue.front(data), 2);
+  BOOST_CHECK_EQUAL(data[0], 2);
+  BOOST_CHECK_EQUAL(data[1], 3);
+  queue.pop(2);
+  BOOST_REQUIRE_EQUAL(queue.front(data), 2);
+  BOOST_CHECK_EQUAL(data[0], 4);
+  BOOST_CHECK_EQUAL(data[1], 5);
+  queue.pop(2);
+  queue.close();
+  BOOST_CHECK_EQUAL(queue.front(data), 0);
+}
+
+// The producer is much faster than the queue capacity, so it waits for the consumer.
+BOOST_AUTO_TEST_CASE(backpressure) {
+  constexpr int size = 100000;
+  SpscQueue<int> queue{16};
+  std::thread producer([&] {
+    for (int i = 0; i < size; ++i) {
+      queue.back() = i;
+      queue.push();
+    }
+    queue.close();
+  });
+  std::vector<int> received;
+  int *data;
+  while (const std::size_t count = queue.front(data)) {
+    BOOST_REQUIRE_LE(count, queue.capacity());
+    received.insert(received.end(), data, data + count);
+    queue.pop(count);
+  }
+  producer.join();
+  BOOST_REQUIRE_EQUAL(received.size(), size);
+  for (int i = 0; i < size; ++i) {
+    BOOST_REQUIRE_EQUAL(received[i], i);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,54 @@
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
+#include "../src/string_pool.hh"
+
+BOOST_AUTO_TEST_SUITE(StringPoolTest)
+
+BOOST_AUTO_TEST_CASE(internSame) {
+  const InternedString alice{"Alice"};
+  const InternedString bob{std::string("Bob")};
+  BOOST_CHECK_EQUAL(alice, InternedString(std::string_view("Alice")));
+  BOOST_CHECK_NE(alice, bob);
+  BOOST_CHECK_EQUAL(alice.str(), "Alice");
+  BOOST_CHECK_EQUAL(bob.str(), "Bob");
+}
+
+BOOST_AUTO_TEST_CASE(empty) {
+  BOOST_CHECK_EQUAL(InternedString().id(), 0);
+  BOOST_CHECK_EQUAL(InternedString("").id(), 0);
+  BOOST_CHECK_EQUAL(InternedString().str(), "");
+}
+
+// The strings in the first chunk must not be moved when the later chunks are allocated.
+BOOST_AUTO_TEST_CASE(manyStrings) {
+  const InternedString first{"first"};
+  const std::string *firstAddress = &first.str();
+  std::vector<InternedString> strings;
+  for (int i = 0; i < 5000; ++i) {
+    strings.emplace_back("string" + std::to_string(i));
+  }
+  BOOST_CHECK_EQUAL(&first.str(), firstAddress);
+  BOOST_CHECK_EQUAL(first.str(), "first");
+  for (int i = 0; i < 5000; ++i) {
+    BOOST_CHECK_EQUAL(strings[i].str(), "string" + std::to_string(i));
+    BOOST_CHECK_EQUAL(strings[i], InternedString("string" + std::to_string(i)));
+  }
+}
+
+// Only a new string grows the pool.
+BOOST_AUTO_TEST_CASE(memoryInBytes) {
+  StringPool &pool = StringPool::global();
+  const InternedString existing{"memoryInBytes"};
+  const std::size_t size = pool.size();
+  const std::size_t bytes = pool.memoryInBytes();
+  BOOST_CHECK_EQUAL(InternedString("memoryInBytes"), existing);
+  BOOST_CHECK_EQUAL(pool.size(), size);
+  BOOST_CHECK_EQUAL(pool.memoryInBytes(), bytes);
+  const std::string longString(100, 'x');
+  InternedString{longString};
+  BOOST_CHECK_EQUAL(pool.size(), size + 1);
+  BOOST_CHECK_GT(pool.memoryInBytes(), bytes + longString.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -19,7 +19,7 @@ BOOST_AUTO_TEST_SUITE(SymbolicStringConstraintTests)
       using type = Symbolic::StringAtom;
       type result = lexical_cast<type>(str);
       BOOST_CHECK_EQUAL(result.value.index(), 1);
-      BOOST_CHECK_EQUAL(std::get<std::string>(result.value), "string");
+      BOOST_CHECK_EQUAL(std::get<InternedString>(result.value), "string");
     }
 
     BOOST_AUTO_TEST_CASE(varEqConstant) {
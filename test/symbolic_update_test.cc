@@ -40,7 +40,7 @@ BOOST_AUTO_TEST_SUITE(SymbolicDataConstraintsTest)
 
     BOOST_AUTO_TEST_CASE(stringVectorEqPass) {
       Parma_Polyhedra_Library::NNC_Polyhedron numEnv;
-      Symbolic::StringValuation stringEnv = {std::vector<std::string>{"Alice"}};
+      Symbolic::StringValuation stringEnv = {std::vector<InternedString>{"Alice"}};
       std::vector<Symbolic::StringConstraint> stringConstraints = {Symbolic::SCMaker(0) == "Bob"};
       std::vector<Symbolic::NumberConstraint> numberConstraints;
       BOOST_TEST(Symbolic::eval(stringConstraints, stringEnv, numberConstraints, numEnv));
@@ -48,7 +48,7 @@ BOOST_AUTO_TEST_SUITE(SymbolicDataConstraintsTest)
 
     BOOST_AUTO_TEST_CASE(stringVectorNeNonIncludePass) {
       Parma_Polyhedra_Library::NNC_Polyhedron numEnv;
-      Symbolic::StringValuation stringEnv = {std::vector<std::string>{"Alice"}};
+      Symbolic::StringValuation stringEnv = {std::vector<InternedString>{"Alice"}};
       std::vector<Symbolic::StringConstraint> stringConstraints = {Symbolic::SCMaker(0) != "Bob"};
       std::vector<Symbolic::NumberConstraint> numberConstraints;
       BOOST_TEST(Symbolic::eval(stringConstraints, stringEnv, numberConstraints, numEnv));
@@ -56,7 +56,7 @@ BOOST_AUTO_TEST_SUITE(SymbolicDataConstraintsTest)
 
     BOOST_AUTO_TEST_CASE(stringVectorEqFail) {
       Parma_Polyhedra_Library::NNC_Polyhedron numEnv;
-      Symbolic::StringValuation stringEnv = {std::vector<std::string>{"Alice"}};
+      Symbolic::StringValuation stringEnv = {std::vector<InternedString>{"Alice"}};
       std::vector<Symbolic::StringConstraint> stringConstraints = {Symbolic::SCMaker(0) == "Alice"};
       std::vector<Symbolic::NumberConstraint> numberConstraints;
       BOOST_TEST(!Symbolic::eval(stringConstraints, stringEnv, numberConstraints, numEnv));
@@ -64,7 +64,7 @@ BOOST_AUTO_TEST_SUITE(SymbolicDataConstraintsTest)
 
     BOOST_AUTO_TEST_CASE(stringVectorNeIncludePass) {
       Parma_Polyhedra_Library::NNC_Polyhedron numEnv;
-      Symbolic::StringValuation stringEnv = {std::vector<std::string>{"Alice"}};
+      Symbolic::StringValuation stringEnv = {std::vector<InternedString>{"Alice"}};
       std::vector<Symbolic::StringConstraint> stringConstraints = {Symbolic::SCMaker(0) != "Alice"};
       std::vector<Symbolic::NumberConstraint> numberConstraints;
       BOOST_TEST(Symbolic::eval(stringConstraints, stringEnv, numberConstraints, numEnv));
@@ -161,8 +161,8 @@ BOOST_AUTO_TEST_SUITE(SymbolicDataConstraintsTest)
       Symbolic::NumberValuation numEnv;
       Symbolic::Update update = {stringUpdate, numUpdate};
       update.execute(stringEnv, numEnv);
-      BOOST_CHECK_EQUAL(std::get<std::string>(stringEnv[0]), "Charlie");
-      BOOST_CHECK_EQUAL(std::get<std::string>(stringEnv[1]), "Charlie");
+      BOOST_CHECK_EQUAL(std::get<InternedString>(stringEnv[0]), "Charlie");
+      BOOST_CHECK_EQUAL(std::get<InternedString>(stringEnv[1]), "Charlie");
     }
 
     BOOST_AUTO_TEST_CASE(stringExecute2) {
@@ -170,7 +170,7 @@ BOOST_AUTO_TEST_SUITE(SymbolicDataConstraintsTest)
       std::vector<Symbolic::NumberConstraint> numberConstraints;
       std::vector<std::pair<VariableID, Symbolic::NumberExpression>> numUpdate;
 
-      Symbolic::StringValuation stringEnv = {std::vector<std::string>{}, std::vector<std::string>{}};
+      Symbolic::StringValuation stringEnv = {std::vector<InternedString>{}, std::vector<InternedString>{}};
       std::vector<Symbolic::StringConstraint> stringConstraints1 = {
         Symbolic::SCMaker(0) != "Alice",
         Symbolic::SCMaker(0) != "Bob",
@@ -187,8 +187,8 @@ BOOST_AUTO_TEST_SUITE(SymbolicDataConstraintsTest)
       Symbolic::Update update = {stringUpdate, numUpdate};
       update.execute(stringEnv, numEnv);
       // After the update, stringEnv[0] is "Charlie", and stringEnv[1] is disabled for "Alice", "Bob", "Charlie"
-      BOOST_CHECK_EQUAL(std::get<std::string>(stringEnv[0]), "Charlie");
-      BOOST_CHECK_EQUAL(std::get<std::vector<std::string>>(stringEnv[1]).size(), 3);
+      BOOST_CHECK_EQUAL(std::get<InternedString>(stringEnv[0]), "Charlie");
+      BOOST_CHECK_EQUAL(std::get<std::vector<InternedString>>(stringEnv[1]).size(), 3);
 
       std::vector<Symbolic::StringConstraint> stringConstraints2 = {Symbolic::SCMaker(1) == "Charlie"};
       BOOST_TEST(!Symbolic::eval(stringConstraints2, stringEnv, numberConstraints, numEnv));
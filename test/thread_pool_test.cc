@@ -0,0 +1,69 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <vector>
+#include "../src/thread_pool.hh"
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(parallelFor) {
+  ThreadPool pool{4};
+  BOOST_CHECK_EQUAL(pool.size(), 4);
+  // The pool is reused by many parallelFor calls
+  for (std::size_t n: {0, 1, 3, 100, 1000}) {
+    std::vector<int> counts(n);
+    pool.parallelFor(n, [&](std::size_t i) { counts[i]++; });
+    for (const int count: counts) {
+      BOOST_CHECK_EQUAL(count, 1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(singleThread) {
+  ThreadPool pool{1};
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+  std::vector<std::size_t> order;
+  pool.parallelFor(5, [&](std::size_t i) { order.push_back(i); });
+  BOOST_TEST(order == std::vector<std::size_t>({0, 1, 2, 3, 4}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(exception) {
+  ThreadPool pool{4};
+  std::atomic<int> count = 0;
+  BOOST_CHECK_THROW(pool.parallelFor(100,
+                                     [&](std::size_t i) {
+                                       if (i == 10) {
+                                         throw std::runtime_error("error");
+                                       }
+                                       count++;
+                                     }),
+                    std::runtime_error);
+  BOOST_TEST(count < 100);
+  // The pool is still usable after an exception
+  count = 0;
+  pool.parallelFor(100, [&](std::size_t) { count++; });
+  BOOST_CHECK_EQUAL(count, 100);
+}
+
+// The tasks of a slow thread are stolen by the others, and the slot identifies the running thread.
+BOOST_AUTO_TEST_CASE(workStealing) {
+  ThreadPool pool{4};
+  std::vector<int> counts(1000);
+  std::vector<std::size_t> slots(1000);
+  pool.parallelFor(1000, [&](std::size_t i, std::size_t slot) {
+    if (i == 0) {
+      // The thread running the first task is blocked for a while, and the rest of its range is stolen.
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    counts[i]++;
+    slots[i] = slot;
+  });
+  for (std::size_t i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(counts[i], 1);
+    BOOST_TEST(slots[i] < pool.size());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,49 @@
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include "../src/timed_word_subject.hh"
+
+BOOST_AUTO_TEST_SUITE(TimedWordSubjectTest)
+
+//! @brief Record the sizes of the batches and the timestamps of the events
+struct BatchRecorder : public Observer<TimedWordEvent<int>> {
+  void notify(const TimedWordEvent<int> &event) override {
+    timestamps.push_back(event.timestamp);
+  }
+  void notifyBatch(const TimedWordEvent<int> *events, std::size_t size) override {
+    batchSizes.push_back(size);
+    Observer<TimedWordEvent<int>>::notifyBatch(events, size);
+  }
+  std::vector<std::size_t> batchSizes;
+  std::vector<double> timestamps;
+};
+
+struct TimedWordSubjectFixture {
+  std::vector<std::size_t> run(int events, std::size_t batchSize) {
+    std::stringstream sigStream;
+    sigStream << "withdraw\t1\t1";
+    Signature sig(sigStream);
+    std::stringstream wordStream;
+    for (int i = 0; i < events; ++i) {
+      wordStream << "withdraw\tAlice\t100\t" << i << "\n";
+    }
+    TimedWordSubject<int> subject{std::make_unique<TimedWordParser<int>>(wordStream, sig), batchSize};
+    const auto recorder = std::make_shared<BatchRecorder>();
+    subject.addObserver(recorder);
+    subject.parseAndSubjectAll();
+    BOOST_REQUIRE_EQUAL(recorder->timestamps.size(), events);
+    for (int i = 0; i < events; ++i) {
+      BOOST_CHECK_EQUAL(recorder->timestamps[i], i);
+    }
+    return recorder->batchSizes;
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(batches, TimedWordSubjectFixture) {
+  BOOST_TEST(run(5, 2) == std::vector<std::size_t>({2, 2, 1}), boost::test_tools::per_element());
+  // No empty batch is notified at the end
+  BOOST_TEST(run(4, 2) == std::vector<std::size_t>({2, 2}), boost::test_tools::per_element());
+  BOOST_TEST(run(0, 2).empty());
+  BOOST_TEST(run(3, 1) == std::vector<std::size_t>({1, 1, 1}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,4 +26,27 @@ BOOST_AUTO_TEST_SUITE(TimingConstraintTest)
         BOOST_CHECK(constraint.satisfy(0.6));
     }
 
+    BOOST_AUTO_TEST_CASE(Bounds) {
+        // 1 < x0 <= 3 && x0 < 5 && x1 == 2
+        const std::vector<TimingConstraint> guard = {ConstraintMaker(0) > 1, ConstraintMaker(0) <= 3,
+                                                     ConstraintMaker(0) < 5, ConstraintMaker(1) == 2};
+        const TimingBounds bounds(guard);
+        BOOST_CHECK(bounds.isSatisfiable());
+        BOOST_CHECK_EQUAL(bounds.clockSize(), 2);
+        for (const std::vector<double> &val: std::vector<std::vector<double>>{
+                 {0.5, 2}, {1, 2}, {1.5, 2}, {3, 2}, {3.5, 2}, {2, 1.5}, {2, 2.5}}) {
+            BOOST_CHECK_EQUAL(bounds.satisfy(val), eval(val, guard));
+        }
+        BOOST_CHECK(bounds.satisfy(std::vector<double>{3, 2}));
+        BOOST_CHECK(!bounds.satisfy(std::vector<double>{1, 2}));
+    }
+
+    BOOST_AUTO_TEST_CASE(UnsatisfiableBounds) {
+        BOOST_CHECK(!TimingBounds({ConstraintMaker(0) > 3, ConstraintMaker(0) < 2}).isSatisfiable());
+        BOOST_CHECK(!TimingBounds({ConstraintMaker(0) >= 2, ConstraintMaker(0) < 2}).isSatisfiable());
+        BOOST_CHECK(TimingBounds({ConstraintMaker(0) >= 2, ConstraintMaker(0) <= 2}).isSatisfiable());
+        BOOST_CHECK(!TimingBounds({ConstraintMaker(0) > 3, ConstraintMaker(0) < 2}).satisfy(std::vector<double>{2.5}));
+        BOOST_CHECK(TimingBounds().satisfy(std::vector<double>{}));
+    }
+
 BOOST_AUTO_TEST_SUITE_END() // TimingConstraintTest
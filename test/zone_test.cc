@@ -0,0 +1,81 @@
+#include <boost/test/unit_test.hpp>
+#include <limits>
+#include "../src/zone.hh"
+
+BOOST_AUTO_TEST_SUITE(ZoneTest)
+
+const double infinity = std::numeric_limits<double>::infinity();
+
+BOOST_AUTO_TEST_CASE(elapseAndReset) {
+  Zone zone(2);
+  zone.elapse(1.5);
+  zone.reset(1);
+  zone.elapse(2);
+  // x0 == 3.5 and x1 == 2
+  BOOST_CHECK_EQUAL(zone.at(1, 0).value, 3.5);
+  BOOST_CHECK_EQUAL(zone.at(0, 1).value, -3.5);
+  BOOST_CHECK_EQUAL(zone.at(2, 0).value, 2);
+  BOOST_CHECK_EQUAL(zone.at(1, 2).value, 1.5);
+  BOOST_CHECK_EQUAL(zone.at(2, 1).value, -1.5);
+}
+
+BOOST_AUTO_TEST_CASE(constrain) {
+  Zone zone(1);
+  zone.elapse(2);
+  BOOST_TEST(zone.intersects(TimingBounds({ConstraintMaker(0) >= 2})));
+  BOOST_TEST(!zone.intersects(TimingBounds({ConstraintMaker(0) > 2})));
+  BOOST_TEST(!zone.intersects(TimingBounds({ConstraintMaker(0) < 1})));
+  Zone copy = zone;
+  BOOST_TEST(copy.constrain(TimingBounds({ConstraintMaker(0) <= 2})));
+  BOOST_TEST((copy == zone));
+  BOOST_TEST(!copy.constrain(TimingBounds({ConstraintMaker(0) < 2})));
+}
+
+BOOST_AUTO_TEST_CASE(extrapolate) {
+  // The guards compare x0 with at most 3 and never compare x1.
+  const std::vector<double> maxConstants = {3, -infinity};
+  Zone first(2), second(2);
+  first.elapse(5);
+  second.elapse(7);
+  BOOST_TEST((first != second));
+  first.extrapolate(maxConstants);
+  second.extrapolate(maxConstants);
+  BOOST_TEST((first == second));
+  BOOST_CHECK_EQUAL(hash_value(first), hash_value(second));
+  // x0 > 3
+  BOOST_CHECK(first.at(1, 0).isInfinity());
+  BOOST_CHECK_EQUAL(first.at(0, 1).value, -3);
+  BOOST_CHECK(first.at(0, 1).strict);
+  BOOST_TEST(!first.intersects(TimingBounds({ConstraintMaker(0) <= 3})));
+  BOOST_TEST(first.intersects(TimingBounds({ConstraintMaker(0) > 3})));
+
+  // A value below the maximum constant is kept.
+  Zone third(2);
+  third.elapse(2);
+  third.extrapolate(maxConstants);
+  BOOST_CHECK_EQUAL(third.at(1, 0).value, 2);
+  BOOST_CHECK_EQUAL(third.at(0, 1).value, -2);
+  BOOST_TEST(first.contains(first));
+  BOOST_TEST(!first.contains(third));
+  BOOST_TEST(!third.contains(first));
+}
+
+BOOST_AUTO_TEST_CASE(delay) {
+  Zone zone(2);
+  zone.elapse(1);
+  zone.reset(1);
+  // x0 == 1 and x1 == 0
+  BOOST_CHECK_EQUAL(zone.delay({ConstraintMaker(0) == 3}).value(), 2);
+  BOOST_CHECK_EQUAL(zone.delay({ConstraintMaker(0) == 3, ConstraintMaker(1) == 2}).value(), 2);
+  BOOST_TEST(!zone.delay({ConstraintMaker(0) == 3, ConstraintMaker(1) == 3}).has_value());
+  // Time does not go backward.
+  BOOST_TEST(!zone.delay({ConstraintMaker(0) == 0.5}).has_value());
+  BOOST_CHECK_EQUAL(zone.delay({}).value(), 0);
+  BOOST_CHECK_THROW((void)zone.delay({ConstraintMaker(0) < 3}), std::runtime_error);
+  // The value of x0 is forgotten beyond its maximum constant.
+  zone.elapse(5);
+  zone.extrapolate({3, 3});
+  BOOST_TEST(!zone.delay({ConstraintMaker(0) == 3}).has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()